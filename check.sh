@@ -0,0 +1,122 @@
+#!/bin/bash
+# make check: every way of searching should find the same cliques as the plain search.
+# The graphs are generated here, with awk; the cliques are compared with each clique's names sorted, and then the lines sorted.
+# usage: ./check.sh [directory with the binaries, by default this one]
+
+BIN=$(cd "${1:-.}" && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+cd "$WORK"
+failures=0
+checks=0
+
+canonical() { perl -lane 'print join " ", sort @F' | LC_ALL=C sort; }
+cliques() { "$BIN/justTheCliques" "$@" 2>/dev/null | canonical; }
+histogram() { "$BIN/justTheCliques" "$@" 2>&1 >/dev/null | grep -P '^\d+\t#\d+$'; }
+pass_if() { # pass_if description command...
+	local what="$1"; shift
+	checks=$((checks + 1))
+	if "$@"; then
+		echo "ok    $what"
+	else
+		echo "FAIL  $what"
+		failures=$((failures + 1))
+	fi
+}
+same() { cmp -s "$1" "$2"; }
+
+# G(n,p), with the names spread out and some negative, so that they aren't just 0 ... n-1
+gnp() { awk -v n=$1 -v p=$2 -v seed=$3 'BEGIN { srand(seed); for(u = 0; u < n; u++) for(v = u + 1; v < n; v++) if(rand() < p) print u * 7919 - 50000, v * 7919 - 50000 }'; }
+# sparse, with a few hubs whose neighbourhoods are too big for the bitset kernel, and some repeated edges both ways round
+hubs() { awk -v seed=$1 'BEGIN { srand(seed); n = 3000
+	for(i = 0; i < 4 * n; i++) { u = int(rand() * n); v = int(rand() * n); if(u != v) print u, v }
+	for(h = 0; h < 4; h++) for(i = 0; i < 700; i++) { v = 10 + int(rand() * (n - 10)); print h, v; if(rand() < 0.05) print v, h }
+	for(i = 0; i < 3000; i++) { u = 10 + int(rand() * 700); v = 10 + int(rand() * 700); if(u != v) print u "\t" v } }'; }
+
+gnp 400 0.06 1 > gnp.txt
+gnp 120 0.4 2 > dense.txt
+hubs 3 > hubs.txt
+awk '{ print "n" $1 ",node" $2 }' gnp.txt > strings.txt
+
+for graph in gnp dense hubs; do
+	case $graph in dense) big_k=5 ;; *) big_k=4 ;; esac
+	for k in 3 $big_k; do
+		cliques $graph.txt -k $k > ref
+		[ -s ref ] || { echo "FAIL  $graph k=$k found no cliques to compare with"; failures=$((failures + 1)); }
+		for mode in "--threads 3" "--degeneracy" "--truss" "--relabel degree" "--relabel rcm" "--relabel bfs" "--csr" "--csr --truss" \
+				"--adjacency-index" "--parallel-load --threads 2" "--degeneracy --truss --relabel rcm --csr --threads 2"; do
+			cliques $graph.txt -k $k $mode > out
+			pass_if "$graph k=$k $mode" same ref out
+		done
+
+		histogram $graph.txt -k $k > ref.histogram
+		histogram $graph.txt -k $k --count-only --threads 2 > out.histogram
+		pass_if "$graph k=$k --count-only" same ref.histogram out.histogram
+
+		awk '{ print NF }' ref | sort -n | tail -5 > ref.sizes
+		cliques $graph.txt -k $k --top 5 | awk '{ print NF }' | sort -n > out.sizes
+		pass_if "$graph k=$k --top 5" same ref.sizes out.sizes
+	done
+	"$BIN/justTheCliques" $graph.txt --maximum 2>/dev/null | awk '{ print NF }' > out.sizes
+	cliques $graph.txt | awk '{ print NF }' | sort -n | tail -1 > ref.sizes
+	pass_if "$graph --maximum" same ref.sizes out.sizes
+
+	"$BIN/graph-compile" $graph.txt $graph.cg 2>/dev/null
+	"$BIN/graph-compile" $graph.txt $graph.parallel.cg --parallel-load --threads 3 2>/dev/null
+	pass_if "$graph graph-compile, with and without --parallel-load" same $graph.cg $graph.parallel.cg
+	cliques $graph.txt > ref
+	cliques $graph.cg > out
+	pass_if "$graph compiled" same ref out
+	cliques $graph.cg --truss --relabel degree --threads 2 > out
+	pass_if "$graph compiled --truss --relabel degree --threads 2" same ref out
+done
+
+cliques strings.txt --stringIDs > ref
+for mode in "--parallel-load" "--parallel-load --threads 3" "--relabel rcm --truss"; do
+	cliques strings.txt --stringIDs $mode > out
+	pass_if "strings $mode" same ref out
+done
+"$BIN/graph-compile" strings.txt strings.cg --stringIDs --parallel-load --threads 2 2>/dev/null
+cliques strings.cg > out
+pass_if "strings compiled" same ref out
+
+# shards, merged back, whatever the options of each shard, as long as they're the same search
+cliques hubs.txt -k 4 > ref
+for s in 0 1 2; do
+	"$BIN/justTheCliques" hubs.txt -k 4 --degeneracy --shard $s/3 --threads $((s + 1)) -o shard$s 2>/dev/null
+done
+"$BIN/mergeShards" shard0 shard1 shard2 2>/dev/null | canonical > out
+pass_if "3 shards, merged" same ref out
+pass_if "mergeShards refuses a missing shard" eval '! "$BIN/mergeShards" shard0 shard2 >/dev/null 2>&1'
+"$BIN/justTheCliques" hubs.txt -k 4 --degeneracy --truss --shard 1/3 -o shard1.truss 2>/dev/null
+pass_if "mergeShards refuses a shard from a different search" eval '! "$BIN/mergeShards" shard0 shard1.truss shard2 >/dev/null 2>&1'
+
+# killed with SIGKILL as soon as there's a checkpoint, and resumed. It takes a few seconds, so that the first checkpoint (after a second) comes before the end
+gnp 700 0.35 5 > slow.txt
+cliques slow.txt -k 8 > ref
+"$BIN/justTheCliques" slow.txt -k 8 --relabel degree -o resumed --checkpoint resumed.checkpoint --checkpoint-seconds 1 >/dev/null 2>&1 &
+search=$!
+while kill -0 $search 2>/dev/null; do
+	if [ -s resumed.checkpoint ]; then
+		kill -KILL $search 2>/dev/null && echo "      (killed after the first checkpoint)"
+		break
+	fi
+	sleep 0.1
+done
+wait $search 2>/dev/null
+"$BIN/justTheCliques" slow.txt -k 8 --relabel degree -o resumed --checkpoint resumed.checkpoint --resume >/dev/null 2>&1
+canonical < resumed > out
+pass_if "killed and resumed" same ref out
+pass_if "--resume refuses a checkpoint from a different search" eval '! "$BIN/justTheCliques" slow.txt -k 7 -o resumed --checkpoint resumed.checkpoint --resume >/dev/null 2>&1'
+
+# an incremental update: the cliques after the changes, as if found from scratch in the changed graph
+cliques gnp.txt -k 3 > before
+awk 'NR % 50 == 0 { print "-", $1, $2 } END { srand(4); for(i = 0; i < 200; i++) print "+", (int(rand() * 400) * 7919 - 50000), (int(rand() * 400) * 7919 - 50000) }' gnp.txt \
+	| awk '$2 != $3' > changes
+"$BIN/updateCliques" gnp.txt before changes --cliques-out updated --edges-out updated.txt >/dev/null 2>&1
+canonical < updated > out
+cliques updated.txt -k 3 > ref
+pass_if "updateCliques, against a fresh search" same ref out
+
+echo "$((checks - failures)) of $checks checks passed"
+[ $failures = 0 ]
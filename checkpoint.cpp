@@ -0,0 +1,167 @@
+#include "checkpoint.hpp"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <cstdio>
+#include <unistd.h>
+#include <fcntl.h>
+#include "macros.hpp"
+using namespace std;
+
+namespace checkpoint {
+
+static const char * const MAGIC = "maximal-cliques-checkpoint";
+static const int VERSION = 4;
+
+Checkpointer :: Checkpointer(const string &_file_name, int _output_fd, const Header &_header
+		, int64_t _output_bytes, const vector<char> &_roots_done, int _seconds_between_checkpoints)
+	: file_name(_file_name), output_fd(_output_fd), header(_header)
+	, output_bytes(_output_bytes), roots_done(_roots_done), seconds_between_checkpoints(_seconds_between_checkpoints)
+	, last_checkpoint(time(NULL)) {
+	this->roots_done.resize(_header.num_nodes, 0);
+}
+
+void Checkpointer :: written(const writer :: Buffer &b) {
+	this->output_bytes += b.used;
+	For(root, b.roots_done)
+		this->roots_done.at(*root) = 1;
+	if(time(NULL) - this->last_checkpoint >= this->seconds_between_checkpoints)
+		this->save();
+}
+
+static bool write_all(int fd, const string &s) {
+	const char *p = s.data();
+	size_t n = s.size();
+	while(n > 0) {
+		const ssize_t written = ::write(fd, p, n);
+		if(written < 0) {
+			if(errno == EINTR)
+				continue;
+			return false;
+		}
+		p += written;
+		n -= written;
+	}
+	return true;
+}
+
+void Checkpointer :: save() {
+	this->last_checkpoint = time(NULL);
+	if(0 != fsync(this->output_fd) && errno != EINVAL) { // EINVAL: it's a pipe or the like, which can't be resumed anyway
+		cerr << "Warning: no checkpoint, as the output couldn't be synced: " << strerror(errno) << endl;
+		return;
+	}
+
+	ostringstream text;
+	text << MAGIC << ' ' << VERSION << '\n'
+		<< "nodes " << this->header.num_nodes << '\n'
+		<< "k " << this->header.minimum_size << '\n'
+		<< "degeneracy " << (this->header.degeneracy_order ? 1 : 0) << '\n'
+		<< "shard " << this->header.shard << ' ' << this->header.num_shards << '\n'
+		<< "relabel " << this->header.relabel << '\n'
+		<< "truss " << (this->header.truss ? 1 : 0) << '\n'
+		<< "output_bytes " << this->output_bytes << '\n';
+	vector< pair<int32_t, int32_t> > ranges; // [first,last) runs of finished roots
+	for(int32_t v = 0; v < this->header.num_nodes; v++) {
+		unless(this->roots_done[v])
+			continue;
+		if(!ranges.empty() && ranges.back().second == v)
+			ranges.back().second = v + 1;
+		else
+			ranges.push_back(make_pair(v, v + 1));
+	}
+	text << "done_ranges " << ranges.size() << '\n';
+	For(r, ranges)
+		text << r->first << ' ' << r->second << '\n';
+	text << "end\n";
+
+	const string tmp_name = this->file_name + ".tmp";
+	const int fd = open(tmp_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	bool ok = fd >= 0 && write_all(fd, text.str()) && 0 == fsync(fd);
+	if(fd >= 0)
+		ok = (0 == ::close(fd)) && ok;
+	ok = ok && 0 == rename(tmp_name.c_str(), this->file_name.c_str());
+	unless(ok)
+		cerr << "Warning: failed to write the checkpoint " << this->file_name << ": " << strerror(errno) << endl;
+}
+
+bool load(const string &file_name, const Header &expected, int64_t &output_bytes, vector<char> &roots_done) {
+	ifstream in(file_name.c_str());
+	unless(in)
+		return false;
+	string magic, key;
+	int version = 0;
+	Header found;
+	int degeneracy = 0, truss = 0;
+	size_t num_ranges = 0;
+	in >> magic >> version;
+	unless(in && magic == MAGIC && version == VERSION)
+		throw std :: runtime_error("not a checkpoint that this version can read: " + file_name);
+	in >> key >> found.num_nodes;
+	in >> key >> found.minimum_size;
+	in >> key >> degeneracy;
+	found.degeneracy_order = degeneracy != 0;
+	in >> key >> found.shard >> found.num_shards;
+	in >> key >> found.relabel;
+	in >> key >> truss;
+	found.truss = truss != 0;
+	in >> key >> output_bytes;
+	in >> key >> num_ranges;
+	unless(in)
+		throw std :: runtime_error("the checkpoint is damaged: " + file_name);
+	unless(found.num_nodes == expected.num_nodes && found.minimum_size == expected.minimum_size && found.degeneracy_order == expected.degeneracy_order
+			&& found.shard == expected.shard && found.num_shards == expected.num_shards && found.relabel == expected.relabel
+			&& found.truss == expected.truss)
+		throw std :: runtime_error("the checkpoint is for a different network, k, order, relabeling, truss, or shard: " + file_name);
+	roots_done.assign(found.num_nodes, 0);
+	for(size_t r = 0; r < num_ranges; r++) {
+		int32_t first = 0, last = 0;
+		in >> first >> last;
+		unless(in && 0 <= first && first < last && last <= found.num_nodes)
+			throw std :: runtime_error("the checkpoint is damaged: " + file_name);
+		for(int32_t v = first; v < last; v++)
+			roots_done[v] = 1;
+	}
+	in >> key;
+	unless(in && key == "end")
+		throw std :: runtime_error("the checkpoint is damaged: " + file_name);
+	return true;
+}
+
+void tally_cliques(const char *file_name, int64_t bytes, vector<int64_t> &frequencies) {
+	ifstream in(file_name, ios :: binary);
+	unless(in)
+		throw std :: runtime_error(string("can't read the output, to resume it: ") + file_name);
+	vector<char> chunk(1 << 20);
+	size_t fields = 0;
+	bool in_field = false;
+	while(bytes > 0) {
+		const int64_t want = bytes < int64_t(chunk.size()) ? bytes : int64_t(chunk.size());
+		in.read(&chunk.front(), want);
+		unless(in.gcount() == want)
+			throw std :: runtime_error(string("the output is shorter than the checkpoint says: ") + file_name);
+		bytes -= want;
+		for(int64_t i = 0; i < want; i++) {
+			const char c = chunk[i];
+			if(c == '\n') {
+				if(in_field)
+					++ fields;
+				if(frequencies.size() <= fields)
+					frequencies.resize(fields + 1);
+				++ frequencies[fields];
+				fields = 0;
+				in_field = false;
+			} else if(c == ' ') {
+				if(in_field)
+					++ fields;
+				in_field = false;
+			} else
+				in_field = true;
+		}
+	}
+}
+
+} // namespace checkpoint
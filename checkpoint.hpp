@@ -0,0 +1,63 @@
+#ifndef _CHECKPOINT_HPP_
+#define _CHECKPOINT_HPP_
+
+#include "writer.hpp"
+#include <vector>
+#include <string>
+#include <ctime>
+
+/*
+ * Checkpoints for a long enumeration, so that it can be resumed after it's killed.
+ *
+ * A checkpoint records a length of the output file and the roots whose cliques are exactly the cliques in
+ * that much of the file. The search only passes a buffer to the writer between roots, so every buffer
+ * ends on a root boundary; we learn about the buffers in the order they're written (see WriteListener).
+ * To resume, truncate the output to that length and skip those roots.
+ *
+ * The output is fsync'ed before the checkpoint that describes it is written, and the checkpoint is
+ * written to a temporary file and then renamed over the old one, so there's always a consistent checkpoint.
+ */
+
+namespace checkpoint {
+
+struct Header { // a checkpoint is only any good for the same search
+	int32_t num_nodes;
+	int32_t minimum_size;
+	bool degeneracy_order;
+	int shard, num_shards;
+	int relabel; // a relabel :: Order
+	bool truss;
+};
+
+class Checkpointer : public writer :: WriteListener {
+public:
+	// output_bytes and roots_done are where we're starting from: nothing, or what was loaded from a checkpoint
+	Checkpointer(const std :: string &file_name, int output_fd, const Header &header
+			, int64_t output_bytes, const std :: vector<char> &roots_done, int seconds_between_checkpoints);
+	virtual void written(const writer :: Buffer &b);
+	void save(); // a checkpoint now. Failures are reported on stderr, but the search carries on
+private:
+	const std :: string file_name;
+	const int output_fd;
+	const Header header;
+	int64_t output_bytes;
+	std :: vector<char> roots_done;
+	const int seconds_between_checkpoints;
+	time_t last_checkpoint;
+};
+
+/*
+ * Read a checkpoint. Returns false if there's no such file.
+ * Throws std :: runtime_error if it can't be read, or it's for a different search.
+ */
+bool load(const std :: string &file_name, const Header &expected, int64_t &output_bytes, std :: vector<char> &roots_done);
+
+/*
+ * Count the cliques, by size, in the first 'bytes' of an output file, with one clique per line.
+ * To restore the histogram when resuming.
+ */
+void tally_cliques(const char *file_name, int64_t bytes, std :: vector<int64_t> &frequencies);
+
+} // namespace checkpoint
+
+#endif
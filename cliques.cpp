@@ -1,13 +1,25 @@
 #include "cliques.hpp"
-#include "misc/list_with_constant_size.hpp"
+#include "parallel.hpp"
+#include "ordering.hpp"
+#include "graph_view.hpp"
+#include "truss.hpp"
+#include "checkpoint.hpp"
+#include "shard.hpp"
+#include "search_stats.hpp"
+#include "root_report.hpp"
+#include "writer.hpp"
 #include <set>
 #include <map>
-#include <list>
+#include <deque>
 #include <vector>
 #include <stdexcept>
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
 #include "macros.hpp"
 using namespace std;
 
@@ -16,100 +28,577 @@ using namespace std;
 namespace cliques {
 
 typedef int32_t V;
-typedef misc :: list_with_constant_size<V> list_of_ints;
+typedef const graph_view :: Graph * SearchGraph;
+typedef graph_view :: Neighbours Neighbours;
 typedef set<V> not_type;
 
 struct CliqueReceiver;
-static void cliquesWorker(const SimpleIntGraph &g, CliqueReceiver *send_cliques_here, unsigned int minimumSize, vector<V> & Compsub, list_of_ints Not, list_of_ints Candidates);
-static void findCliques(const SimpleIntGraph &g, CliqueReceiver *cliquesOut, unsigned int minimumSize, const bool verbose);
-static void cliquesForOneNode(const SimpleIntGraph &g, CliqueReceiver *send_cliques_here, int minimumSize, V v);
-static void find_node_with_fewest_discs(int &fewestDisc, int &fewestDiscVertex, bool &fewestIsInCands, const list_of_ints &Not, const list_of_ints &Candidates, const SimpleIntGraph &g);
+struct SearchState;
+struct Frame;
+static void cliquesWorker(SearchState &s, vector<V> & Compsub);
+static void findCliques(const compiled_graph :: Input &input, const vector<CliqueReceiver *> &cliquesOut, unsigned int minimumSize, const bool verbose, const SearchOptions &options, const vector<char> &roots_to_skip = vector<char>()); // one receiver per thread
+static void searchRoots(const SearchGraph &g, const vector<V> &roots, const vector<CliqueReceiver *> &receivers, unsigned int minimumSize, const bool verbose, const vector<int32_t> &position, const vector<char> &in_core, const vector<char> &roots_to_skip, root_report :: TopRoots *root_costs, const int32_t *original_ids);
+static void searchOneRoot(SearchState &s, V v, const vector<int32_t> &position, const vector<char> &in_core, const vector<char> &roots_to_skip);
+static void cliquesForOneNode(SearchState &s, V v, const vector<int32_t> &position, const vector<char> &in_core);
+static void find_node_with_fewest_discs(int &fewestDisc, int &fewestDiscVertex, bool &fewestIsInCands, const Frame &f, SearchState &s);
+static void add_frequencies(std :: vector<int64_t> &total, const std :: vector<int64_t> &one_thread);
+static void print_frequencies(const std :: vector<int64_t> &cliqueFrequencies, unsigned int minimumSize);
 static const bool verbose = false;
+CLIQUE_STAT(static search_stats :: Counters search_totals;) // from every search since the last dump_search_stats()
+CLIQUE_STAT(static void dump_search_stats();)
 
 /*
  * Candidates is always sorted
  * Compsub isn't sorted, but it's a vector and doens't need to be looked up anyway.
- * Not ?
+ * Not is sorted too, but the Candidates moved into it by the current frame are kept apart, in Frame::moved.
  */
 
+/*
+ * The cliques are handed over in batches: the node ids of many cliques, back-to-back in one flat array.
+ * Clique i is nodes[offsets[i]] ... nodes[offsets[i+1]-1], and it's sorted.
+ * The arrays belong to the search, and are reused as soon as receive_cliques() returns.
+ * A receiver that only wants the sizes can say so with wants_nodes(); then 'nodes' is NULL, and the cliques aren't even sorted.
+ */
+static const size_t CLIQUE_BATCH_NODES = 1 << 14; // pass the batch on once it has this many node ids
+struct CliqueBatch {
+	const V *nodes;
+	const size_t *offsets; // count+1 of them
+	size_t count;
+	const V * clique_begin(const size_t i) const { return this->nodes + this->offsets[i]; }
+	const V * clique_end  (const size_t i) const { return this->nodes + this->offsets[i+1]; }
+	size_t    clique_size (const size_t i) const { return this->offsets[i+1] - this->offsets[i]; }
+};
 struct CliqueReceiver {
-	virtual void receive_unsorted_clique (std::vector<V> clique) = 0;
+	virtual void receive_cliques (const CliqueBatch &batch) = 0;
+	virtual bool wants_nodes() const { return true; }
+	/* A receiver can raise the minimum size as the search goes on (see CliquesTopN). The search asks after every batch.
+	 * Such a receiver should also ask for small batches, so that the search hears about it promptly.
+	 */
+	virtual unsigned int minimum_size_wanted() const { return 0; }
+	virtual size_t max_batch_nodes() const { return CLIQUE_BATCH_NODES; }
+	/* A receiver that wants to know when each root is finished (for a checkpoint) says so with wants_roots().
+	 * Then the batch is passed on at the end of every root, just before root_done().
+	 */
+	virtual bool wants_roots() const { return false; }
+	virtual void root_done(V) {}
 	virtual ~CliqueReceiver() {}
 };
 
-static void cliquesForOneNode(const SimpleIntGraph &g, CliqueReceiver *send_cliques_here, int minimumSize, V v) {
+struct Frame { // the sets for one level of the recursion, as flat sorted arrays
+	vector<V> Candidates;
+	vector<V> Not;
+	vector<V> moved; // the Candidates this frame has tried, and hence moved to Not.
+	                 // They're tried in increasing order, so this stays sorted without any inserting.
+};
+
+class ConnectionsBounds { // a bound for some of the nodes, in an open-addressing hash table, at most half full
+public:
+	ConnectionsBounds() : used(0), shift(64) {}
+	int32_t & at(const V v) { // a node that isn't in the table yet goes in with no bound, i.e. int32_t's max
+		unless(2 * (this->used + 1) <= this->slots.size())
+			this->grow();
+		size_t slot = this->slot_of(v);
+		while(this->slots[slot].first != v) {
+			if(this->slots[slot].first == EMPTY) {
+				this->slots[slot] = make_pair(v, numeric_limits<int32_t> :: max());
+				this->filled.push_back(slot);
+				++ this->used;
+				break;
+			}
+			slot = (slot + 1) & (this->slots.size() - 1);
+		}
+		return this->slots[slot].second;
+	}
+	void clear() {
+		For(slot, this->filled)
+			this->slots[*slot].first = EMPTY;
+		this->filled.clear();
+		this->used = 0;
+	}
+private:
+	static const V EMPTY = -1;
+	vector< pair<V, int32_t> > slots;
+	vector<size_t> filled; // which slots are in use, so that clear() costs no more than filling them did
+	size_t used;
+	int shift;
+	size_t slot_of(const V v) const { return size_t((uint64_t(uint32_t(v)) * 0x9E3779B97F4A7C15ULL) >> this->shift); }
+	void grow() {
+		vector< pair<V, int32_t> > old;
+		old.swap(this->slots);
+		this->slots.resize(old.empty() ? 64 : 2 * old.size(), make_pair(EMPTY, 0));
+		this->shift = 64;
+		for(size_t capacity = this->slots.size(); capacity > 1; capacity /= 2)
+			-- this->shift;
+		this->filled.clear();
+		this->used = 0;
+		For(entry, old)
+			if(entry->first != EMPTY) {
+				size_t slot = this->slot_of(entry->first);
+				while(this->slots[slot].first != EMPTY)
+					slot = (slot + 1) & (this->slots.size() - 1);
+				this->slots[slot] = *entry;
+				this->filled.push_back(slot);
+				++ this->used;
+			}
+	}
+};
+const V ConnectionsBounds :: EMPTY;
+
+struct SearchState { // everything that one thread needs for its part of the search
+	const SearchGraph g;
+	CliqueReceiver * const send_cliques_here;
+	unsigned int minimumSize; // only ever raised, by the receiver. See minimum_size_wanted()
+
+	/* The arena: the frame for recursion depth d is frames[d], where d is Compsub.size().
+	 * The vectors are reused from one call to the next, so once they have grown to
+	 * the size they need, the recursion doesn't allocate anything.
+	 * (A deque, so that adding a deeper frame doesn't move the others.)
+	 */
+	deque<Frame> frames;
+	vector<V> Compsub;
+	Frame & frame(const size_t depth) {
+		while(this->frames.size() <= depth)
+			this->frames.push_back(Frame());
+		return this->frames[depth];
+	}
+
+	/* For each node, an upper bound on how many of the current Candidates it is connected to.
+	 * The pivot engine finds these counts in one frame, and they remain valid bounds
+	 * in every frame below it, as Candidates only ever shrink as we go down.
+	 * Each frame restores its parent's bounds, via the undo log, before returning.
+	 * Only the nodes counted since the log was last empty are in the table, so it's as big as a root's neighbourhood, not numNodes.
+	 */
+	ConnectionsBounds connections_bound;
+	vector< pair<V, int32_t> > connections_bound_undo;
+
+	// the cliques found, but not yet passed to send_cliques_here. See CliqueBatch
+	const bool batch_wants_nodes;
+	const size_t batch_max_nodes;
+	const bool batch_wants_roots;
+	vector<V> batch_nodes;
+	vector<size_t> batch_offsets;
+
+	CLIQUE_STAT(search_stats :: Counters counters;)
+
+	// always counted, as they cost next to nothing. Only needed for the root_costs
+	int64_t search_nodes; // calls to cliquesWorker and cliquesWorkerBitset
+	int64_t cliques_found;
+	root_report :: TopRoots *root_costs; // NULL, unless there's to be a root report
+	const int32_t *original_ids; // if the graph is relabeled (see relabel.hpp), the ids to give the receiver. Otherwise NULL
+
+	// for splitting big subtrees off to idle threads (see SubtreeTask). spawner is NULL if we can't
+	parallel :: Spawner *spawner;
+	const vector<SearchState *> *thread_states; // the state of each thread, for the tasks to run with
+
+	SearchState(const SearchGraph &_g, CliqueReceiver *_send_cliques_here, unsigned int _minimumSize)
+		: g(_g), send_cliques_here(_send_cliques_here), minimumSize(_minimumSize)
+		, batch_wants_nodes(_send_cliques_here->wants_nodes())
+		, batch_max_nodes(_send_cliques_here->max_batch_nodes())
+		, batch_wants_roots(_send_cliques_here->wants_roots())
+		, batch_offsets(1, 0)
+		, search_nodes(0), cliques_found(0), root_costs(NULL), original_ids(NULL)
+		, spawner(NULL), thread_states(NULL) {}
+	void found_clique(const vector<V> &Compsub) {
+		++ this->cliques_found;
+		if(this->batch_wants_nodes) {
+			const size_t start = this->batch_nodes.size();
+			if(this->original_ids)
+				For(v, Compsub)
+					this->batch_nodes.push_back(this->original_ids[*v]);
+			else
+				this->batch_nodes.insert(this->batch_nodes.end(), Compsub.begin(), Compsub.end());
+			sort(this->batch_nodes.begin() + start, this->batch_nodes.end());
+		}
+		this->batch_offsets.push_back(this->batch_offsets.back() + Compsub.size());
+		if(this->batch_offsets.back() >= this->batch_max_nodes)
+			this->flush_cliques();
+	}
+	void flush_cliques() {
+		const size_t count = this->batch_offsets.size() - 1;
+		if(count == 0)
+			return;
+		CliqueBatch batch;
+		batch.nodes = this->batch_wants_nodes ? &this->batch_nodes.front() : NULL;
+		batch.offsets = &this->batch_offsets.front();
+		batch.count = count;
+		this->send_cliques_here->receive_cliques(batch);
+		this->batch_nodes.clear();
+		this->batch_offsets.resize(1);
+		if(this->minimumSize < this->send_cliques_here->minimum_size_wanted())
+			this->minimumSize = this->send_cliques_here->minimum_size_wanted();
+	}
+	void tighten_connections_bound(const V v, int32_t &known_bound, const int32_t bound) { // known_bound is connections_bound.at(v)
+		if(bound < known_bound) {
+			this->connections_bound_undo.push_back(make_pair(v, known_bound));
+			known_bound = bound;
+		}
+	}
+};
+struct RestoreConnectionsBoundsOnReturn {
+	SearchState &s;
+	const size_t undo_mark;
+	RestoreConnectionsBoundsOnReturn(SearchState &_s) : s(_s), undo_mark(_s.connections_bound_undo.size()) {}
+	~RestoreConnectionsBoundsOnReturn() {
+		while(s.connections_bound_undo.size() > undo_mark) {
+			s.connections_bound.at(s.connections_bound_undo.back().first) = s.connections_bound_undo.back().second;
+			s.connections_bound_undo.pop_back();
+		}
+		if(s.connections_bound_undo.empty()) // then every bound in the table is 'none'
+			s.connections_bound.clear();
+	}
+};
+
+/*
+ * Each maximal clique is found exactly once: from the root that comes first in the order.
+ * 'position' is that order (the degeneracy order); if it's empty, we use the node ids.
+ * Only the nodes in the (minimumSize-1)-core are used, as no big enough clique has a node outside it.
+ * A clique is maximal in that core iff it's maximal in the whole graph, so the neighbours
+ * outside the core needn't even go into Not.
+ */
+static void cliquesForOneNode(SearchState &s, V v, const vector<int32_t> &position, const vector<char> &in_core) {
+	const SearchGraph &g = s.g;
 	const int d = g->degree(v);
-	if(d + 1 < minimumSize)
+	if(d + 1 < int(s.minimumSize))
 		return; // Obviously no chance of a clique if the degree is too small.
+	unless(in_core[v])
+		return;
 
 
-	vector<V> Compsub;
-	list_of_ints Not, Candidates;
+	vector<V> &Compsub = s.Compsub;
+	Compsub.clear();
 	Compsub.push_back(v);
+	Frame &f = s.frame(Compsub.size());
+	vector<V> &Not = f.Not;
+	vector<V> &Candidates = f.Candidates;
+	Not.clear();
+	Candidates.clear();
 
 
 	// copy those below the split into Not
 	// copy those above the split into Candidates
 	// there shouldn't ever be a neighbour equal to the split, this'd mean a self-loop
+	// Either way, Not and Candidates are sorted by node id, as the intersections need.
 	{
-		const vector<int32_t> &neighs_of_v = g->neighbouring_nodes_in_order(v);
+		const Neighbours neighs_of_v = g->neighbours(v);
 		int32_t last_neighbour_id = -1;
-		for(vector<int32_t> :: const_iterator i = neighs_of_v.begin(); i != neighs_of_v.end(); i++) {
+		for(Neighbours :: const_iterator i = neighs_of_v.begin(); i != neighs_of_v.end(); i++) {
 			const int neighbour_id = *i;
-
-			if(neighbour_id < v)
-				Not.push_back(neighbour_id);
-			if(neighbour_id > v)
-				Candidates.push_back(neighbour_id);
-
 			assert(last_neighbour_id < neighbour_id);
 			last_neighbour_id = neighbour_id;
+			unless(in_core[neighbour_id])
+				continue;
+
+			if(position.empty()) {
+				if(neighbour_id < v)
+					Not.push_back(neighbour_id);
+				if(neighbour_id > v)
+					Candidates.push_back(neighbour_id);
+			} else {
+				if(position[neighbour_id] < position[v])
+					Not.push_back(neighbour_id);
+				if(position[neighbour_id] > position[v])
+					Candidates.push_back(neighbour_id);
+			}
 		}
 	}
 
-	assert(d == int(Not.size() + Candidates.size()));
+	assert(d >= int(Not.size() + Candidates.size()));
 
-	cliquesWorker(g, send_cliques_here, minimumSize, Compsub, Not, Candidates);
+	cliquesWorker(s, Compsub);
 }
 
-static inline void tryCandidate (const SimpleIntGraph & g, CliqueReceiver *send_cliques_here, unsigned int minimumSize, vector<V> & Compsub, const list_of_ints & Not, const list_of_ints & Candidates, const V selected) {
+/*
+ * Append to 'out' those nodes, from the two sorted disjoint ranges [a,a_end) and [b,b_end), that are in 'neighs'.
+ * The ranges are merged as we go, so 'out' is sorted.
+ */
+static inline void intersect_into(vector<V> &out, const V *a, const V *a_end, const V *b, const V *b_end, const Neighbours neighs) {
+	if(neighs.empty())
+		return;
+	const V *n = neighs.begin();
+	const V * const n_end = neighs.end();
+	const bool look_up = neighs.size() > 8 * size_t((a_end - a) + (b_end - b)); // a high-degree node. Binary search rather than merge
+	while(a != a_end || b != b_end) {
+		const V x = (b == b_end || (a != a_end && *a < *b)) ? *a++ : *b++;
+		if(look_up)
+			n = lower_bound(n, n_end, x);
+		else
+			while(n != n_end && *n < x)
+				++n;
+		if(n == n_end)
+			return;
+		if(*n == x)
+			out.push_back(x);
+	}
+}
+
+/*
+ * Splitting a root between threads.
+ * Once the roots run out, one or two expensive roots can leave the other threads idle. So, while a thread
+ * is idle, a branch near the top of the search (no deeper than SPLIT_MAX_DEPTH) with at least
+ * SPLIT_MIN_CANDIDATES Candidates is handed over as a task, instead of being searched there and then.
+ * That's in either engine; the bitset kernel's branches are turned back into lists of node ids.
+ * The branches of Bron-Kerbosch are independent once their Candidates and Not are known,
+ * so the task just needs its own copy of those and of Compsub.
+ * The cliques go to the receiver of whichever thread runs the task. A receiver that needs to know
+ * when each root is finished (see wants_roots()) can't allow that, so there's no splitting for them.
+ */
+static const size_t SPLIT_MAX_DEPTH = 4;
+static const size_t SPLIT_MIN_CANDIDATES = 64;
+struct SubtreeTask : public parallel :: Task {
+	parallel :: Spawner * const spawner;
+	const vector<SearchState *> &states;
+	vector<V> Compsub;
+	vector<V> Candidates;
+	vector<V> Not;
+	SubtreeTask(const SearchState &s, const vector<V> &_Compsub, const Frame &f)
+		: spawner(s.spawner), states(*s.thread_states), Compsub(_Compsub), Candidates(f.Candidates), Not(f.Not) {}
+	SubtreeTask(const SearchState &s, const vector<V> &_Compsub) // the caller fills in Candidates and Not
+		: spawner(s.spawner), states(*s.thread_states), Compsub(_Compsub) {}
+	virtual void run(int thread_id) {
+		SearchState &s = *this->states.at(thread_id); // the thread is between roots, so its Compsub and frames are free
+		s.spawner = this->spawner;
+		s.Compsub.swap(this->Compsub);
+		Frame &f = s.frame(s.Compsub.size());
+		f.Candidates.swap(this->Candidates);
+		f.Not.swap(this->Not);
+		cliquesWorker(s, s.Compsub);
+	}
+};
+
+static inline void tryCandidate (SearchState &s, vector<V> & Compsub, const Frame &f, const size_t cands_kept, const size_t cands_untried_from, const V selected) {
+	// The current Candidates are f.Candidates[0,cands_kept) and f.Candidates[cands_untried_from,end). The current Not is f.Not and f.moved.
 	// it *might* be the case that the 'selected' node is still in Candidates, but we can rely on the intersection to remove it (assuming no self loops! )
 	assert(!Compsub.empty());
 	Compsub.push_back(selected); // Compsub does *not* have to be ordered. I might try to enforce that in future though.
 
-	list_of_ints CandidatesNew_;
-	list_of_ints NotNew_;
-	
-	const vector<int32_t> &neighs_of_selected = g->neighbouring_nodes_in_order(selected);
-	set_intersection(Candidates.get().begin()            , Candidates.get().end()
-			, neighs_of_selected.begin(), neighs_of_selected.end()
-			,back_inserter(CandidatesNew_));
-	set_intersection(Not.get().begin()                 , Not.get().end()
-			, neighs_of_selected.begin(), neighs_of_selected.end()
-			,back_inserter(NotNew_));
+	Frame &next = s.frame(Compsub.size());
+	next.Candidates.clear();
+	next.Not.clear();
+
+	const Neighbours neighs_of_selected = s.g->neighbours(selected);
+	const V *cands = f.Candidates.empty() ? NULL : &f.Candidates.front();
+	intersect_into(next.Candidates
+			, cands, cands + cands_kept
+			, cands + cands_untried_from, cands + f.Candidates.size()
+			, neighs_of_selected);
+	CLIQUE_STAT(s.counters.intersection(cands_kept + (f.Candidates.size() - cands_untried_from), neighs_of_selected.size(), next.Candidates.size());)
+	const V *nots = f.Not.empty() ? NULL : &f.Not.front();
+	const V *moved = f.moved.empty() ? NULL : &f.moved.front();
+	intersect_into(next.Not
+			, nots, nots + f.Not.size()
+			, moved, moved + f.moved.size()
+			, neighs_of_selected);
+	CLIQUE_STAT(s.counters.intersection(f.Not.size() + f.moved.size(), neighs_of_selected.size(), next.Not.size());)
 
-	cliquesWorker(g, send_cliques_here, minimumSize, Compsub, NotNew_, CandidatesNew_);
+	if(s.spawner && Compsub.size() <= SPLIT_MAX_DEPTH && next.Candidates.size() >= SPLIT_MIN_CANDIDATES && s.spawner->hungry())
+	{
+		s.spawner->spawn(new SubtreeTask(s, Compsub, next));
+		CLIQUE_STAT(++ s.counters.subtrees_split;)
+	} else
+		cliquesWorker(s, Compsub);
 
 	Compsub.pop_back(); // we must restore Compsub, it was passed by reference
 }
 
-static void cliquesWorker(const SimpleIntGraph &g, CliqueReceiver *send_cliques_here, unsigned int minimumSize, vector<V> & Compsub, list_of_ints Not, list_of_ints Candidates) {
+/*
+ * The bit-parallel kernel.
+ * Once Candidates and Not are small, we renumber them 0..n-1, build their adjacency as a
+ * bit-matrix, and do the rest of this subtree with word-level ANDs and popcounts.
+ * Everything lives on the stack; P and X are at most BITSET_KERNEL_WORDS words each.
+ */
+static const int32_t BITSET_KERNEL_MAX_NODES = 256; // switch to the kernel once |Candidates|+|Not| is at most this
+static const int32_t BITSET_KERNEL_WORDS = BITSET_KERNEL_MAX_NODES / 64;
+typedef uint64_t bitset_word;
+
+struct BitsetSubproblem {
+	int32_t n;
+	int32_t words; // how many words of each row are in use
+	V local_to_global[BITSET_KERNEL_MAX_NODES];
+	bitset_word adjacency[BITSET_KERNEL_MAX_NODES][BITSET_KERNEL_WORDS];
+};
+
+static inline int32_t count_bits(const bitset_word *bits, const int32_t words) {
+	int32_t c = 0;
+	for(int32_t w = 0; w < words; w++)
+		c += __builtin_popcountll(bits[w]);
+	return c;
+}
+static inline int32_t count_bits_and(const bitset_word *a, const bitset_word *b, const int32_t words) {
+	int32_t c = 0;
+	for(int32_t w = 0; w < words; w++)
+		c += __builtin_popcountll(a[w] & b[w]);
+	return c;
+}
+
+static void build_bitset_subproblem(const SearchGraph &g, const vector<V> &Not, const vector<V> &Candidates, BitsetSubproblem &sp, bitset_word *P, bitset_word *X) {
+	sp.n = int32_t(Not.size() + Candidates.size());
+	assert(sp.n <= BITSET_KERNEL_MAX_NODES);
+	sp.words = (sp.n + 63) / 64;
+	for(int32_t w = 0; w < sp.words; w++) {
+		P[w] = 0;
+		X[w] = 0;
+	}
+	{ // merge the two sorted lists, so that local_to_global is sorted too
+		vector<V> :: const_iterator n = Not.begin();
+		vector<V> :: const_iterator c = Candidates.begin();
+		const vector<V> :: const_iterator n_end = Not.end();
+		const vector<V> :: const_iterator c_end = Candidates.end();
+		for(int32_t i = 0; i < sp.n; i++) {
+			const bool fromNot = c == c_end || (n != n_end && *n < *c);
+			sp.local_to_global[i] = fromNot ? *n++ : *c++;
+			(fromNot ? X : P)[i / 64] |= bitset_word(1) << (i % 64);
+		}
+	}
+	for(int32_t i = 0; i < sp.n; i++) {
+		bitset_word *row = sp.adjacency[i];
+		for(int32_t w = 0; w < sp.words; w++)
+			row[w] = 0;
+		const Neighbours neighs = g->neighbours(sp.local_to_global[i]);
+		if(neighs.size() <= size_t(8 * sp.n)) { // merge
+			Neighbours :: const_iterator it = neighs.begin();
+			for(int32_t j = 0; j < sp.n && it != neighs.end(); ) {
+				if(*it < sp.local_to_global[j])
+					++ it;
+				else {
+					if(*it == sp.local_to_global[j])
+						row[j / 64] |= bitset_word(1) << (j % 64);
+					++ j;
+				}
+			}
+		} else { // a high-degree node. Look up each of the n nodes instead
+			Neighbours :: const_iterator it = neighs.begin();
+			for(int32_t j = 0; j < sp.n; j++) {
+				it = lower_bound(it, neighs.end(), sp.local_to_global[j]);
+				if(it == neighs.end())
+					break;
+				if(*it == sp.local_to_global[j])
+					row[j / 64] |= bitset_word(1) << (j % 64);
+			}
+		}
+		assert(0 == (row[i / 64] & (bitset_word(1) << (i % 64)))); // no self-loops
+	}
+}
+
+static SubtreeTask * bitset_subtree_task(const SearchState &s, const BitsetSubproblem &sp, const vector<V> &Compsub, const bitset_word *P, const bitset_word *X) {
+	// back to lists of node ids. The thread that runs it builds its own bit-matrix
+	SubtreeTask *task = new SubtreeTask(s, Compsub);
+	for(int32_t i = 0; i < sp.n; i++) { // local_to_global is sorted, so these are too
+		const bitset_word bit = bitset_word(1) << (i % 64);
+		if(P[i / 64] & bit)
+			task->Candidates.push_back(sp.local_to_global[i]);
+		else if(X[i / 64] & bit)
+			task->Not.push_back(sp.local_to_global[i]);
+	}
+	return task;
+}
+
+static void cliquesWorkerBitset(SearchState &s, const BitsetSubproblem &sp, vector<V> & Compsub, const bitset_word *P_in, const bitset_word *X_in) {
+	const unsigned int &minimumSize = s.minimumSize; // a reference, as it may be raised while we're in here
+	CLIQUE_STAT(s.counters.bitset_worker_call(Compsub.size());)
+	++ s.search_nodes;
+	const int32_t W = sp.words;
+	bitset_word P[BITSET_KERNEL_WORDS], X[BITSET_KERNEL_WORDS];
+	for(int32_t w = 0; w < W; w++) {
+		P[w] = P_in[w];
+		X[w] = X_in[w];
+	}
+	int32_t sizeP = count_bits(P, W);
+	unless(sizeP + Compsub.size() >= minimumSize) return;
+	if(sizeP == 0) {
+		if(count_bits(X, W) == 0 && Compsub.size() >= minimumSize)
+			s.found_clique(Compsub);
+		return;
+	}
+
+	// the pivot: the node, in Not or in Candidates, with the most neighbours in Candidates
+	int32_t pivot = -1;
+	int32_t most_connections = -1;
+	bool pivotIsInCands = false;
+	for(int32_t w = 0; w < W && most_connections < sizeP; w++) {
+		bitset_word bits = P[w] | X[w];
+		while(bits) {
+			const int32_t u = w * 64 + __builtin_ctzll(bits);
+			bits &= bits - 1;
+			const int32_t c = count_bits_and(P, sp.adjacency[u], W);
+			if(c > most_connections) {
+				most_connections = c;
+				pivot = u;
+				pivotIsInCands = P[w] & (bitset_word(1) << (u % 64));
+				if(c == sizeP)
+					break; // can't do better than this
+			}
+		}
+	}
+	assert(pivot >= 0);
+	CLIQUE_STAT(s.counters.pivot(sizeP, sizeP - most_connections, !pivotIsInCands);)
+	if(!pivotIsInCands && most_connections == sizeP) return; // something in Not is connected to everything in Cands. Just give up now!
+
+	// only the Candidates that aren't connected to the pivot need to be tried. (If the pivot is a Candidate, it's one of them.)
+	bitset_word branch[BITSET_KERNEL_WORDS];
+	for(int32_t w = 0; w < W; w++)
+		branch[w] = P[w] & ~sp.adjacency[pivot][w];
+	for(int32_t w = 0; w < W; w++) {
+		while(branch[w]) {
+			const int32_t b = __builtin_ctzll(branch[w]);
+			branch[w] &= branch[w] - 1;
+			const int32_t v = w * 64 + b;
+			unless(sizeP + Compsub.size() >= minimumSize) return;
+
+			bitset_word P_new[BITSET_KERNEL_WORDS], X_new[BITSET_KERNEL_WORDS];
+			for(int32_t w2 = 0; w2 < W; w2++) {
+				P_new[w2] = P[w2] & sp.adjacency[v][w2];
+				X_new[w2] = X[w2] & sp.adjacency[v][w2];
+			}
+			Compsub.push_back(sp.local_to_global[v]);
+			if(s.spawner && Compsub.size() <= SPLIT_MAX_DEPTH && count_bits(P_new, W) >= int32_t(SPLIT_MIN_CANDIDATES) && s.spawner->hungry()) {
+				s.spawner->spawn(bitset_subtree_task(s, sp, Compsub, P_new, X_new));
+				CLIQUE_STAT(++ s.counters.subtrees_split;)
+			} else
+				cliquesWorkerBitset(s, sp, Compsub, P_new, X_new);
+			Compsub.pop_back();
+
+			P[w] &= ~(bitset_word(1) << b); // move v from Candidates to Not
+			X[w] |= bitset_word(1) << b;
+			-- sizeP;
+		}
+	}
+}
+
+static void cliquesWorker(SearchState &s, vector<V> & Compsub) {
+	const SearchGraph &g = s.g;
+	const unsigned int &minimumSize = s.minimumSize; // a reference, as it may be raised while we're in here
 	assert(g != NULL);
 	// p2p         511462                   (10)
 	// authors000                  (250)    (<4)
 	// authors010  212489     5.3s (4.013)
 
+	Frame &f = s.frame(Compsub.size()); // tryCandidate, or cliquesForOneNode, has filled in Candidates and Not
+	CLIQUE_STAT(s.counters.worker_call(Compsub.size());)
+	++ s.search_nodes;
+	vector<V> &Candidates = f.Candidates;
+	const vector<V> &Not = f.Not;
 
 	unless(Candidates.size() + Compsub.size() >= minimumSize) return;
 
 	if(Candidates.empty()) { // No more cliques to be found. This is the (local) maximal clique.
 		if(Not.empty() && Compsub.size() >= minimumSize)
-			send_cliques_here->receive_unsorted_clique(Compsub);
+			s.found_clique(Compsub);
 		return;
 	}
 
 	assert(!Candidates.empty());
 
+	if(Candidates.size() + Not.size() <= size_t(BITSET_KERNEL_MAX_NODES)) {
+		BitsetSubproblem sp;
+		bitset_word P[BITSET_KERNEL_WORDS], X[BITSET_KERNEL_WORDS];
+		build_bitset_subproblem(g, Not, Candidates, sp, P, X);
+		CLIQUE_STAT(++ s.counters.bitset_kernels;)
+		cliquesWorkerBitset(s, sp, Compsub, P, X);
+		return;
+	}
+
+	RestoreConnectionsBoundsOnReturn restore_bounds(s); // the pivot engine will tighten some bounds
+
 
 	/*
 	 * version 2. Count disconnections-to-Candidates
@@ -119,34 +608,37 @@ static void cliquesWorker(const SimpleIntGraph &g, CliqueReceiver *send_cliques_
 	int32_t fewestDisc = numeric_limits<int32_t> :: max();
 	V fewestDiscVertex = -1;
 	bool fewestIsInCands = false;
-	find_node_with_fewest_discs(fewestDisc, fewestDiscVertex, fewestIsInCands, Not, Candidates, g);
+	f.moved.clear();
+	find_node_with_fewest_discs(fewestDisc, fewestDiscVertex, fewestIsInCands, f, s);
+	CLIQUE_STAT(s.counters.pivot(Candidates.size(), fewestDisc, !fewestIsInCands);)
 	if(!fewestIsInCands && fewestDisc==0) return; // something in Not is connected to everything in Cands. Just give up now!
 	{
-			// list_of_ints CandidatesCopy(Candidates);
-			for( list_of_ints :: iterator i = Candidates.begin(); i != Candidates.end();) {
-				V v = *i;
-				unless(Candidates.size() + Compsub.size() >= minimumSize) return;
+			// The Candidates we don't try are compacted, in order, to the front of the array; those we try go to f.moved
+			const size_t num_cands = Candidates.size();
+			size_t kept = 0;
+			for(size_t i = 0; i < num_cands; i++) {
+				V v = Candidates[i];
+				unless(kept + (num_cands - i) + Compsub.size() >= minimumSize) return;
+				CLIQUE_STAT(if(fewestDisc > 0 && v != fewestDiscVertex) ++ s.counters.are_connected_calls;)
 				if(
 						fewestDisc >0 // speed trick. if it's zero, the call to are_connected is redundant
 						&& v!=fewestDiscVertex // deal with it later - see { if(fewestIsInCands) ... } below
 						&& !g->are_connected(v, fewestDiscVertex)
 					) { // just in case fewestDiscVertex is in Cands
-					unless(Candidates.size() + Compsub.size() >= minimumSize) return;
-					i = Candidates.erase(i);
-					tryCandidate(g, send_cliques_here, minimumSize, Compsub, Not, Candidates, v);
-					list_of_ints :: iterator insertHere = lower_bound(Not.begin(), Not.end(), v);
-					Not.insert(insertHere ,v); // we MUST keep the list Not in order
+					tryCandidate(s, Compsub, f, kept, i+1, v);
+					f.moved.push_back(v); // we MUST keep Not in order. 'moved' is, as we go through the Candidates in order
 					--fewestDisc;
 				} else
-					++i;
+					Candidates[kept++] = v;
 			}
+			Candidates.resize(kept);
 	}
 		// assert(fewestDisc == 0);
 	if(fewestIsInCands) { // The most disconnected node was in the Cands.
 			unless(Candidates.size() + Compsub.size() >= minimumSize) return;
-			// Allow fewestDiscVertex to slip through. Candidates.erase(lower_bound(Candidates.begin(),Candidates.end(),fewestDiscVertex));
-			tryCandidate(g, send_cliques_here, minimumSize, Compsub, Not, Candidates, fewestDiscVertex);
-			// No need as we're about to return...  Not.insert(lower_bound(Not.begin(), Not.end(), fewestDiscVertex) ,fewestDiscVertex); // we MUST keep the list Not in order
+			// Allow fewestDiscVertex to slip through. It's still in Candidates
+			tryCandidate(s, Compsub, f, Candidates.size(), Candidates.size(), fewestDiscVertex);
+			// No need to move it to Not, as we're about to return.
 
 			// Note: fewestDiscVertex is still in Candidates, but it's OK because tryCandidate can handle it.
 	}
@@ -160,55 +652,364 @@ static void cliquesWorker(const SimpleIntGraph &g, CliqueReceiver *send_cliques_
 }
 
 struct CliquesToStdout : public CliqueReceiver {
-	int n;
-	std :: map<size_t, int32_t> cliqueFrequencies;
-	const graph :: NetworkInterfaceConvertedToString *g;
-	CliquesToStdout(const graph :: NetworkInterfaceConvertedToString *_g) : n(0), g(_g) {}
-	virtual void receive_unsorted_clique (vector<V> Compsub) {
-		sort(Compsub.begin(), Compsub.end());
-		bool firstField = true;
-		if(Compsub.size() >= 3) {
-			++ this -> cliqueFrequencies[Compsub.size()];
-			for(vector<V> :: const_iterator v = Compsub.begin(); v != Compsub.end(); ++v) {
-				if(!firstField)
-					std :: cout	<< ' ';
-				std :: cout <<  g->node_name_as_string(*v) ;
-				firstField = false;
+	int64_t n;
+	std :: vector<int64_t> cliqueFrequencies; // indexed by the size of the clique
+	const writer :: NodeNames &names;
+	writer :: FdWriter &out; // shared by the receivers of all the threads
+	writer :: Buffer pending; // passed to 'out' in large pieces
+	const bool checkpointing; // then 'pending' is only passed on between roots, so that the checkpoints can say which roots are written
+	CliquesToStdout(const writer :: NodeNames &_names, writer :: FdWriter &_out, bool _checkpointing) : n(0), names(_names), out(_out), checkpointing(_checkpointing) {}
+	virtual void receive_cliques (const CliqueBatch &batch) {
+		for(size_t c = 0; c < batch.count; c++) {
+			const size_t size = batch.clique_size(c);
+			if(size < 3)
+				continue;
+			if(this->cliqueFrequencies.size() <= size)
+				this->cliqueFrequencies.resize(size+1);
+			++ this -> cliqueFrequencies[size];
+			char * const start = this->pending.reserve(size * (this->names.max_name_length() + 1));
+			char *end = start;
+			for(const V *v = batch.clique_begin(c); v != batch.clique_end(c); ++v) {
+				end = this->names.append_name(end, *v);
+				*end++ = ' ';
 			}
-			std :: cout << endl;
+			end[-1] = '\n';
+			this->pending.used += end - start;
 			this -> n++;
 		}
+		if(!this->checkpointing && this->pending.used > (1 << 20))
+			this->flush();
+	}
+	virtual bool wants_roots() const { return this->checkpointing; }
+	virtual void root_done(V root) {
+		this->pending.roots_done.push_back(root);
+		if(this->pending.used > (1 << 20))
+			this->flush();
+	}
+	void flush() {
+		this->out.write(this->pending);
 	}
 };
 
+struct CliquesCounter : public CliqueReceiver { // just the histogram. One per thread, so there's no sharing
+	std :: vector<int64_t> cliqueFrequencies; // indexed by the size of the clique
+	virtual void receive_cliques (const CliqueBatch &batch) {
+		for(size_t c = 0; c < batch.count; c++) {
+			const size_t size = batch.clique_size(c);
+			if(this->cliqueFrequencies.size() <= size)
+				this->cliqueFrequencies.resize(size+1);
+			++ this -> cliqueFrequencies[size];
+		}
+	}
+	virtual bool wants_nodes() const { return false; }
+};
+
 struct SelfLoopsNotSupportedException {
 };
-static void findCliques(const SimpleIntGraph &g, CliqueReceiver *send_cliques_here, unsigned int minimumSize, const bool verbose) {
+struct RootsInParallel : public parallel :: IndexedTask { // every root vertex is independent of the others
+	const vector<SearchState *> &states;
+	const vector<V> &roots; // if it's empty, every node is a root
+	const vector<int32_t> &position;
+	const vector<char> &in_core;
+	const vector<char> &roots_to_skip;
+	const bool split; // may the roots be split between threads? See SubtreeTask
+	const bool verbose;
+	int32_t roots_done;
+	pthread_mutex_t progress_lock;
+	RootsInParallel(const vector<SearchState *> &_states, const vector<V> &_roots, const vector<int32_t> &_position, const vector<char> &_in_core, const vector<char> &_roots_to_skip, const bool _split, const bool _verbose)
+		: states(_states), roots(_roots), position(_position), in_core(_in_core), roots_to_skip(_roots_to_skip), split(_split), verbose(_verbose), roots_done(0) {
+		pthread_mutex_init(&this->progress_lock, NULL);
+	}
+	~RootsInParallel() {
+		pthread_mutex_destroy(&this->progress_lock);
+	}
+	virtual void run(int64_t i, int thread_id) {
+		SearchState &s = *states.at(thread_id);
+		s.spawner = this->split ? this->spawner : NULL;
+		searchOneRoot(s, roots.empty() ? V(i) : roots.at(i), position, in_core, roots_to_skip);
+		if(verbose) {
+			pthread_mutex_lock(&this->progress_lock);
+			const int32_t done = ++ this->roots_done;
+			if(done % 100 == 0)
+				cerr << "processed nodes: " << done << " ..." << endl;
+			pthread_mutex_unlock(&this->progress_lock);
+		}
+	}
+};
+static void findCliques(const compiled_graph :: Input &input, const vector<CliqueReceiver *> &receivers, unsigned int minimumSize, const bool verbose, const SearchOptions &options, const vector<char> &roots_to_skip) {
 	unless(minimumSize >= 3) throw std :: invalid_argument("the minimumSize for findCliques() must be at least 3");
+	assert(!receivers.empty());
 
-	for(int32_t r = 0; r < g->numRels(); r++) {
-		const pair<int32_t, int32_t> &eps = g->EndPoints(r);
-		unless(eps.first < eps.second) // no selfloops allowed
+	SearchGraph g = input.graph();
+
+	for(V v = 0; v < (V) g->numNodes(); v++) {
+		const Neighbours neighs = g->neighbours(v);
+		if(binary_search(neighs.begin(), neighs.end(), v)) // no selfloops allowed
 			throw SelfLoopsNotSupportedException();
 	}
 
-	for(V v = 0; v < (V) g->numNodes(); v++) {
-		if(verbose && v && v % 100 ==0)
-			cerr << "processing node: " << v << " ..." <<  endl;
-		cliquesForOneNode(g, send_cliques_here, minimumSize, v);
+	std :: auto_ptr<graph_view :: CsrGraph> csr;
+	if(options.csr && options.relabel == relabel :: NONE && !options.truss && !input.csr) { // a CsrNetwork is CSR already
+		csr.reset(new graph_view :: CsrGraph(g));
+		g = csr.get();
+		if(verbose)
+			cerr << "graph copied to CSR: " << csr->bytes() / (1 << 20) << " MB" << endl;
+	}
+
+	std :: auto_ptr<relabel :: RelabeledGraph> relabeled;
+	const int32_t *original_ids = NULL;
+	if(options.relabel != relabel :: NONE) {
+		relabeled.reset(new relabel :: RelabeledGraph(g, options.relabel));
+		g = relabeled.get();
+		original_ids = relabeled->old_of_new.empty() ? NULL : &relabeled->old_of_new.front();
+		if(verbose)
+			cerr << "nodes relabeled in " << relabel :: name(options.relabel) << " order" << endl;
+	}
+
+	graph_view :: AdjacencyLists the_truss; // the same node ids as the network, but only the edges in the k-truss
+	if(options.truss) {
+		const int64_t edges_in_truss = truss :: k_truss(g, minimumSize, int(receivers.size()), the_truss);
+		if(verbose)
+			cerr << "the " << minimumSize << "-truss has " << edges_in_truss << " of the " << input.numRels() << " edges" << endl;
+		g = &the_truss;
+		if(options.csr) {
+			csr.reset(new graph_view :: CsrGraph(g));
+			g = csr.get();
+			graph_view :: AdjacencyLists().lists.swap(the_truss.lists);
+			if(verbose)
+				cerr << "truss copied to CSR: " << csr->bytes() / (1 << 20) << " MB" << endl;
+		}
+	}
+
+	std :: auto_ptr<graph_view :: IndexedGraph> indexed; // for the are_connected() in the candidate loop of cliquesWorker. Otherwise it searches the sorted lists
+	if(options.adjacency_index) {
+		indexed.reset(new graph_view :: IndexedGraph(g));
+		if(verbose)
+			cerr << "adjacency index: " << indexed->index.num_hubs() << " hubs with bit rows, and a hash set for the rest. " << indexed->index.bytes() / (1 << 20) << " MB" << endl;
+		g = indexed.get();
+	}
+
+	vector<char> in_core;
+	const int32_t nodes_in_core = ordering :: k_core(g, minimumSize - 1, in_core);
+	if(verbose)
+		cerr << "the " << (minimumSize - 1) << "-core has " << nodes_in_core << " of the " << g->numNodes() << " nodes" << endl;
+
+	vector<int32_t> position; // empty, unless we're using the degeneracy order
+	if(options.degeneracy_order) {
+		// with this order, no root has more Candidates than the degeneracy of the graph
+		vector<int32_t> order, core_number;
+		ordering :: degeneracy_order(g, order, position, core_number);
+		if(verbose)
+			cerr << "degeneracy order computed. The degeneracy is " << (core_number.empty() ? 0 : *max_element(core_number.begin(), core_number.end())) << endl;
+	}
+
+	std :: auto_ptr<root_report :: TopRoots> root_costs;
+	if(options.root_report)
+		root_costs.reset(new root_report :: TopRoots(options.root_report_top));
+
+	if(options.num_shards > 0) {
+		vector<char> in_shard;
+		const int64_t cost = shard :: roots_of_shard(g, position, in_core, options.shard, options.num_shards, in_shard);
+		vector<char> skip(g->numNodes(), 0);
+		int32_t roots_in_shard = 0;
+		for(V v = 0; v < (V) g->numNodes(); v++) {
+			skip[v] = !in_shard[v] || (!roots_to_skip.empty() && roots_to_skip[v]);
+			roots_in_shard += in_shard[v];
+		}
+		if(verbose)
+			cerr << "shard " << options.shard << '/' << options.num_shards << " has " << roots_in_shard << " roots, with an estimated cost of " << cost << endl;
+		searchRoots(g, vector<V>(), receivers, minimumSize, verbose, position, in_core, skip, root_costs.get(), original_ids);
+	} else
+		searchRoots(g, vector<V>(), receivers, minimumSize, verbose, position, in_core, roots_to_skip, root_costs.get(), original_ids);
+
+	if(root_costs.get()) {
+		root_report :: write(options.root_report, *root_costs, input, g, original_ids);
+		if(verbose)
+			cerr << "the " << options.root_report_top << " heaviest roots are in " << options.root_report << endl;
+	}
+}
+static void searchOneRoot(SearchState &s, V v, const vector<int32_t> &position, const vector<char> &in_core, const vector<char> &roots_to_skip) {
+	if(!roots_to_skip.empty() && roots_to_skip.at(v))
+		return; // an earlier run has written its cliques already
+	if(s.root_costs) {
+		const double start = root_report :: now();
+		const int64_t search_nodes_before = s.search_nodes;
+		const int64_t cliques_before = s.cliques_found;
+		cliquesForOneNode(s, v, position, in_core);
+		root_report :: RootCost cost;
+		cost.root = v;
+		cost.seconds = root_report :: now() - start;
+		cost.search_nodes = s.search_nodes - search_nodes_before;
+		cost.cliques = s.cliques_found - cliques_before;
+		s.root_costs->add(cost);
+	} else
+		cliquesForOneNode(s, v, position, in_core);
+	if(s.batch_wants_roots) {
+		s.flush_cliques();
+		s.send_cliques_here->root_done(v);
 	}
 }
-void cliquesToStdout(const graph :: NetworkInterfaceConvertedToString * net, unsigned int minimumSize /* = 3*/ ) {
+static void searchRoots(const SearchGraph &g, const vector<V> &roots, const vector<CliqueReceiver *> &receivers, unsigned int minimumSize, const bool verbose, const vector<int32_t> &position, const vector<char> &in_core, const vector<char> &roots_to_skip, root_report :: TopRoots *root_costs, const int32_t *original_ids) {
+	// 'roots' are the nodes to search from, or every node if it's empty. 'roots_to_skip' is indexed by node id, or empty
+	// If root_costs isn't NULL, the cost of every root is added to it
+	// If original_ids isn't NULL, g is relabeled, and the cliques are turned back into the original ids for the receivers
+	vector<SearchState *> states;
+	for(size_t t = 0; t < receivers.size(); t++) {
+		states.push_back(new SearchState(g, receivers.at(t), minimumSize));
+		states.back()->original_ids = original_ids;
+		if(root_costs)
+			states.back()->root_costs = new root_report :: TopRoots(root_costs->capacity());
+	}
+	const int64_t num_roots = roots.empty() ? g->numNodes() : int64_t(roots.size());
+	if(receivers.size() == 1) {
+		for(int64_t i = 0; i < num_roots; i++) {
+			if(verbose && i && i % 100 ==0)
+				cerr << "processing node: " << i << " ..." <<  endl;
+			searchOneRoot(*states.front(), roots.empty() ? V(i) : roots.at(i), position, in_core, roots_to_skip);
+		}
+	} else {
+		bool split = true;
+		for(size_t t = 0; t < states.size(); t++) {
+			states.at(t)->thread_states = &states;
+			if(states.at(t)->batch_wants_roots)
+				split = false;
+		}
+		RootsInParallel roots_in_parallel(states, roots, position, in_core, roots_to_skip, split, verbose);
+		parallel :: for_each_index(num_roots, int(receivers.size()), roots_in_parallel);
+	}
+	for(size_t t = 0; t < states.size(); t++) {
+		states.at(t)->flush_cliques();
+		CLIQUE_STAT(search_totals.add(states.at(t)->counters);)
+		if(root_costs) {
+			root_costs->merge(*states.at(t)->root_costs);
+			delete states.at(t)->root_costs;
+		}
+		delete states.at(t);
+	}
+}
+void cliquesToStdout(const compiled_graph :: Input &input, unsigned int minimumSize /* = 3*/, const SearchOptions &options, const OutputOptions &output) {
 	assert(minimumSize >= 3);
+	const int num_threads = options.num_threads < 1 ? 1 : options.num_threads;
+	unless(output.checkpoint_file == NULL || output.output_file != NULL)
+		throw std :: invalid_argument("checkpoints need an output file, not stdout");
+
+	checkpoint :: Header header;
+	header.num_nodes = input.numNodes();
+	header.minimum_size = minimumSize;
+	header.degeneracy_order = options.degeneracy_order;
+	header.shard = options.shard;
+	header.num_shards = options.num_shards;
+	header.relabel = options.relabel;
+	header.truss = options.truss;
+	int64_t output_bytes = 0;
+	vector<char> roots_done; // by an earlier run, if we're resuming
+	std :: vector<int64_t> cliqueFrequencies;
 
-	CliquesToStdout send_cliques_here(net);
-	findCliques(net->get_plain_graph(), & send_cliques_here, minimumSize, true);
-	cerr << send_cliques_here.n << " cliques found" << endl;
-	if(send_cliques_here.n > 0) {
-		assert(!send_cliques_here.cliqueFrequencies.empty());
-		const size_t biggest_clique_found = send_cliques_here.cliqueFrequencies.rbegin()->first;
+	int fd = STDOUT_FILENO;
+	if(output.output_file) {
+		if(output.resume && output.checkpoint_file && checkpoint :: load(output.checkpoint_file, header, output_bytes, roots_done)) {
+			fd = open(output.output_file, O_WRONLY);
+			unless(fd >= 0 && 0 == ftruncate(fd, output_bytes) && output_bytes == lseek(fd, output_bytes, SEEK_SET))
+				throw std :: runtime_error(string("can't truncate the output, to resume it: ") + output.output_file);
+			checkpoint :: tally_cliques(output.output_file, output_bytes, cliqueFrequencies);
+			cerr << "resuming: " << count(roots_done.begin(), roots_done.end(), 1) << " roots done already, and " << output_bytes << " bytes written" << endl;
+		} else
+			fd = open(output.output_file, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+		unless(fd >= 0)
+			throw std :: runtime_error(string("can't open the output file: ") + output.output_file);
+	}
+	std :: auto_ptr<checkpoint :: Checkpointer> checkpointer;
+	if(output.checkpoint_file)
+		checkpointer.reset(new checkpoint :: Checkpointer(output.checkpoint_file, fd, header, output_bytes, roots_done, output.checkpoint_seconds));
+
+	std :: auto_ptr<writer :: NodeNames> loaded_names; // a CsrNetwork has its names already
+	if(input.net)
+		loaded_names.reset(new writer :: NodeNames(input.net));
+	const writer :: NodeNames &names = input.net ? *loaded_names : input.csr->names();
+	std :: cout << std :: flush; // we write to the file descriptor directly from now on
+	writer :: FdWriter out(fd, true, checkpointer.get());
+	vector<CliquesToStdout *> per_thread;
+	vector<CliqueReceiver *> receivers;
+	for(int t = 0; t < num_threads; t++) {
+		per_thread.push_back(new CliquesToStdout(names, out, checkpointer.get() != NULL));
+		receivers.push_back(per_thread.back());
+	}
+	findCliques(input, receivers, minimumSize, true, options, roots_done);
+
+	for(int t = 0; t < num_threads; t++) {
+		CliquesToStdout *send_cliques_here = per_thread.at(t);
+		send_cliques_here->flush();
+		add_frequencies(cliqueFrequencies, send_cliques_here->cliqueFrequencies);
+		delete send_cliques_here;
+	}
+	out.close();
+	if(checkpointer.get())
+		checkpointer->save(); // every root is done
+	if(options.num_shards > 0) { // after the checkpoint, so that resuming a finished shard doesn't repeat the trailer
+		shard :: Trailer trailer;
+		trailer.shard = options.shard;
+		trailer.num_shards = options.num_shards;
+		trailer.num_nodes = input.numNodes();
+		trailer.minimum_size = minimumSize;
+		trailer.degeneracy_order = options.degeneracy_order;
+		trailer.relabel = options.relabel;
+		trailer.truss = options.truss;
+		trailer.cliques = 0;
+		For(frequency, cliqueFrequencies)
+			trailer.cliques += *frequency;
+		const string line = trailer.to_string();
+		writer :: Buffer b;
+		copy(line.begin(), line.end(), b.reserve(line.size()));
+		b.used = line.size();
+		writer :: FdWriter last_line(fd, false);
+		last_line.write(b);
+		last_line.close();
+	}
+	if(fd != STDOUT_FILENO)
+		unless(0 == close(fd))
+			throw std :: runtime_error(string("failed to write the output file: ") + output.output_file);
+	print_frequencies(cliqueFrequencies, minimumSize);
+	CLIQUE_STAT(dump_search_stats();)
+}
+void cliquesCountOnly         (const compiled_graph :: Input &input, unsigned int minimumSize /* = 3*/, const SearchOptions &options ) {
+	assert(minimumSize >= 3);
+	const int num_threads = options.num_threads < 1 ? 1 : options.num_threads;
+
+	vector<CliquesCounter> per_thread(num_threads);
+	vector<CliqueReceiver *> receivers;
+	for(int t = 0; t < num_threads; t++)
+		receivers.push_back(&per_thread.at(t));
+	findCliques(input, receivers, minimumSize, true, options);
+
+	std :: vector<int64_t> cliqueFrequencies;
+	for(int t = 0; t < num_threads; t++)
+		add_frequencies(cliqueFrequencies, per_thread.at(t).cliqueFrequencies);
+	print_frequencies(cliqueFrequencies, minimumSize);
+	CLIQUE_STAT(dump_search_stats();)
+}
+#ifdef CLIQUE_STATS
+static void dump_search_stats() { // as one line of JSON, on stderr
+	search_totals.write_json(cerr);
+	search_totals = search_stats :: Counters();
+}
+#endif
+static void add_frequencies(std :: vector<int64_t> &total, const std :: vector<int64_t> &one_thread) {
+	if(total.size() < one_thread.size())
+		total.resize(one_thread.size());
+	for(size_t i = 0; i < one_thread.size(); i++)
+		total[i] += one_thread[i];
+}
+static void print_frequencies(const std :: vector<int64_t> &cliqueFrequencies, unsigned int minimumSize) {
+	int64_t n = 0;
+	for(size_t i = 0; i < cliqueFrequencies.size(); i++)
+		n += cliqueFrequencies[i];
+
+	cerr << n << " cliques found" << endl;
+	if(n > 0) {
+		assert(!cliqueFrequencies.empty());
+		const size_t biggest_clique_found = cliqueFrequencies.size() - 1;
 		for(size_t i = minimumSize; i <= biggest_clique_found; i++) {
-			cerr << send_cliques_here.cliqueFrequencies[i] << "\t#" << i << endl;
+			cerr << cliqueFrequencies[i] << "\t#" << i << endl;
 		}
 	}
 
@@ -217,66 +1018,205 @@ void cliquesToStdout(const graph :: NetworkInterfaceConvertedToString * net, uns
 struct CliquesToSortedVectorFunctor : public CliqueReceiver {
 	std :: vector< std :: vector<int32_t> > & output_vector;
 	CliquesToSortedVectorFunctor(std :: vector< std :: vector<int32_t> > & _output_vector) : output_vector(_output_vector) {}
-	virtual void receive_unsorted_clique (vector<int32_t> new_clique) {
-		sort(new_clique.begin(), new_clique.end());
-		this->output_vector.push_back(new_clique);
+	virtual void receive_cliques (const CliqueBatch &batch) {
+		for(size_t c = 0; c < batch.count; c++)
+			this->output_vector.push_back(vector<int32_t>(batch.clique_begin(c), batch.clique_end(c)));
 	}
 };
-void cliquesToVector          (const graph :: NetworkInterfaceConvertedToString * net, unsigned int minimumSize, std :: vector< std :: vector<int32_t> > & output_vector ) {
+void cliquesToVector          (const compiled_graph :: Input &input, unsigned int minimumSize, std :: vector< std :: vector<int32_t> > & output_vector, const SearchOptions &options ) {
 	assert(minimumSize >= 3);
-	CliquesToSortedVectorFunctor send_cliques_here( output_vector );
-	findCliques(net->get_plain_graph(), & send_cliques_here, minimumSize, false);
+	const int num_threads = options.num_threads;
+	if(num_threads <= 1) {
+		CliquesToSortedVectorFunctor send_cliques_here( output_vector );
+		findCliques(input, vector<CliqueReceiver *>(1, & send_cliques_here), minimumSize, false, options);
+		CLIQUE_STAT(dump_search_stats();)
+		return;
+	}
+	// each thread fills its own vector, then they're appended in thread order
+	vector< std :: vector< std :: vector<int32_t> > > per_thread_output(num_threads);
+	vector<CliquesToSortedVectorFunctor *> per_thread;
+	vector<CliqueReceiver *> receivers;
+	for(int t = 0; t < num_threads; t++) {
+		per_thread.push_back(new CliquesToSortedVectorFunctor( per_thread_output.at(t) ));
+		receivers.push_back(per_thread.back());
+	}
+	findCliques(input, receivers, minimumSize, false, options);
+	for(int t = 0; t < num_threads; t++) {
+		delete per_thread.at(t);
+		std :: vector< std :: vector<int32_t> > & cliques_from_this_thread = per_thread_output.at(t);
+		for(size_t c = 0; c < cliques_from_this_thread.size(); c++) {
+			output_vector.push_back(std :: vector<int32_t>());
+			output_vector.back().swap(cliques_from_this_thread.at(c));
+		}
+		std :: vector< std :: vector<int32_t> >().swap(cliques_from_this_thread);
+	}
+	CLIQUE_STAT(dump_search_stats();)
 }
 
-static int32_t count_disconnections(const set<int> &cands, const int32_t v, const SimpleIntGraph &g) {
-	const vector<int> &v_neighs = g->neighbouring_nodes_in_order(v);
-	vector<int32_t> intersection;
-	set_intersection( cands.begin(), cands.end()
-			, v_neighs.begin(), v_neighs.end()
-			, back_inserter(intersection)
-			);
-	const int32_t num_connections = int32_t(intersection.size());
+void cliquesAroundNodesToVector(const graph_view :: Graph *g, const std :: vector<int32_t> &nodes, unsigned int minimumSize, std :: vector< std :: vector<int32_t> > & output_vector, const SearchOptions &options ) {
+	unless(minimumSize >= 3) throw std :: invalid_argument("the minimumSize for cliquesAroundNodesToVector() must be at least 3");
+	const int num_threads = options.num_threads < 1 ? 1 : options.num_threads;
+	// Each clique is found from the first of 'nodes' that it contains: the others of 'nodes' go before every other node in the order
+	vector<V> roots(nodes);
+	sort(roots.begin(), roots.end());
+	roots.erase(unique(roots.begin(), roots.end()), roots.end());
+	vector<int32_t> position(g->numNodes(), int32_t(roots.size()));
+	for(size_t i = 0; i < roots.size(); i++)
+		position.at(roots[i]) = int32_t(i);
+	const vector<char> in_core(g->numNodes(), 1);
 
-	/*
-	int currentDiscs = 0;
-	for( list_of_ints :: const_iterator i = Candidates.get().begin(); i != Candidates.get().end(); i++) {
-		V v2 = *i;
-		if(!g->are_connected(v, v2)) {
-			++currentDiscs;
+	vector< std :: vector< std :: vector<int32_t> > > per_thread_output(num_threads);
+	vector<CliquesToSortedVectorFunctor *> per_thread;
+	vector<CliqueReceiver *> receivers;
+	for(int t = 0; t < num_threads; t++) {
+		per_thread.push_back(new CliquesToSortedVectorFunctor( per_thread_output.at(t) ));
+		receivers.push_back(per_thread.back());
+	}
+	searchRoots(g, roots, receivers, minimumSize, false, position, in_core, vector<char>(), NULL, NULL);
+	for(int t = 0; t < num_threads; t++) {
+		delete per_thread.at(t);
+		std :: vector< std :: vector<int32_t> > & cliques_from_this_thread = per_thread_output.at(t);
+		for(size_t c = 0; c < cliques_from_this_thread.size(); c++) {
+			output_vector.push_back(std :: vector<int32_t>());
+			output_vector.back().swap(cliques_from_this_thread.at(c));
 		}
 	}
-	PP3( currentDiscs , num_connections , cands.size() );
-	assert( currentDiscs + num_connections == int(cands.size()) );
-	return currentDiscs;
-	*/
-	return int32_t(cands.size() - num_connections);
+}
 
+/*
+ * The N biggest cliques. Each thread keeps its own N biggest in a min-heap, and once the heap is full,
+ * only a clique bigger than the smallest in the heap is of any interest. That is the new minimum size.
+ * (It's valid for the whole search, as the N biggest overall are at least as big as the N biggest from one thread.)
+ */
+struct CliquesTopN : public CliqueReceiver {
+	const size_t N;
+	std :: vector< std :: vector<int32_t> > heap; // the smallest clique is at the front
+	CliquesTopN(size_t _N) : N(_N) {}
+	static bool bigger(const std :: vector<int32_t> &l, const std :: vector<int32_t> &r) {
+		return l.size() > r.size();
+	}
+	virtual void receive_cliques (const CliqueBatch &batch) {
+		for(size_t c = 0; c < batch.count; c++) {
+			if(this->heap.size() < this->N) {
+				this->heap.push_back(vector<int32_t>(batch.clique_begin(c), batch.clique_end(c)));
+				push_heap(this->heap.begin(), this->heap.end(), bigger);
+			} else if(batch.clique_size(c) > this->heap.front().size()) {
+				pop_heap(this->heap.begin(), this->heap.end(), bigger);
+				this->heap.back().assign(batch.clique_begin(c), batch.clique_end(c));
+				push_heap(this->heap.begin(), this->heap.end(), bigger);
+			}
+		}
+	}
+	virtual unsigned int minimum_size_wanted() const {
+		if(this->N == 0 || this->heap.size() < this->N)
+			return 0;
+		return this->heap.front().size() + 1;
+	}
+	virtual size_t max_batch_nodes() const { return 1; } // every clique might raise the minimum size
+};
+static bool bigger_then_lexicographic(const std :: vector<int32_t> &l, const std :: vector<int32_t> &r) {
+	if(l.size() != r.size())
+		return l.size() > r.size();
+	return l < r;
+}
+void cliquesTopToVector       (const compiled_graph :: Input &input, unsigned int minimumSize, size_t N, std :: vector< std :: vector<int32_t> > & output_vector, const SearchOptions &options ) {
+	assert(minimumSize >= 3);
+	const int num_threads = options.num_threads < 1 ? 1 : options.num_threads;
+	vector<CliquesTopN *> per_thread;
+	vector<CliqueReceiver *> receivers;
+	for(int t = 0; t < num_threads; t++) {
+		per_thread.push_back(new CliquesTopN(N));
+		receivers.push_back(per_thread.back());
+	}
+	findCliques(input, receivers, minimumSize, false, options);
+	for(int t = 0; t < num_threads; t++) {
+		std :: vector< std :: vector<int32_t> > & heap = per_thread.at(t)->heap;
+		for(size_t c = 0; c < heap.size(); c++) {
+			output_vector.push_back(std :: vector<int32_t>());
+			output_vector.back().swap(heap.at(c));
+		}
+		delete per_thread.at(t);
+	}
+	sort(output_vector.begin(), output_vector.end(), bigger_then_lexicographic);
+	if(output_vector.size() > N)
+		output_vector.resize(N);
+}
 
+/*
+ * The pivot engine.
+ * We want the node, in Not or in Candidates, with the most connections to the Candidates.
+ * Each count is a merge, with no allocation, which stops as soon as the node can't beat the best so far.
+ * A node isn't counted at all if an upper bound on its count - |Candidates|, its degree,
+ * or the count found for it in an enclosing frame - can't beat the best so far.
+ */
+static int32_t count_connections(const vector<V> &Candidates, const Neighbours v_neighs, const int32_t must_beat) {
+	// The exact count, if it's more than must_beat. Otherwise, an upper bound on the count that is <= must_beat.
+	vector<V> :: const_iterator c = Candidates.begin();
+	const vector<V> :: const_iterator c_end = Candidates.end();
+	Neighbours :: const_iterator n = v_neighs.begin();
+	const Neighbours :: const_iterator n_end = v_neighs.end();
+	int32_t cands_left = int32_t(Candidates.size());
+	int32_t connections = 0;
+	if(v_neighs.size() > 8 * Candidates.size()) { // a high-degree node. Look up each Candidate instead of merging
+		for(; c != c_end; ++c, --cands_left) {
+			if(connections + cands_left <= must_beat)
+				return connections + cands_left;
+			n = lower_bound(n, n_end, *c);
+			if(n == n_end)
+				break;
+			if(*n == *c)
+				++ connections;
+		}
+		return connections;
+	}
+	int32_t neighs_left = int32_t(v_neighs.size());
+	while(c != c_end && n != n_end) {
+		const int32_t could_still_find = cands_left < neighs_left ? cands_left : neighs_left;
+		if(connections + could_still_find <= must_beat)
+			return connections + could_still_find;
+		if(*c < *n) {
+			++c; --cands_left;
+		} else if(*n < *c) {
+			++n; --neighs_left;
+		} else {
+			++ connections;
+			++c; --cands_left;
+			++n; --neighs_left;
+		}
+	}
+	return connections;
 }
-static void find_node_with_fewest_discs(int &fewestDisc, int &fewestDiscVertex, bool &fewestIsInCands, const list_of_ints &Not, const list_of_ints &Candidates, const SimpleIntGraph &g) {
-	set<int32_t> cands(Candidates.get().begin(), Candidates.get().end());
+static void find_node_with_fewest_discs(int &fewestDisc, int &fewestDiscVertex, bool &fewestIsInCands, const Frame &f, SearchState &s) {
+		const vector<V> &Candidates = f.Candidates;
 		assert(!Candidates.empty());
-		// TODO: Make use of degree, or something like that, to speed up this counting of disconnects?
-		const list_of_ints :: const_iterator not_end = Not.get().end();
-		for(list_of_ints :: const_iterator i = Not.get().begin(); i != not_end; i++) {
-			V v = *i;
-			const int currentDiscs = count_disconnections(cands, v, g);
-			if(currentDiscs < fewestDisc) {
-				fewestDisc = currentDiscs;
-				fewestDiscVertex = v;
-				fewestIsInCands = false;
-				if(!fewestIsInCands && fewestDisc==0) return; // something in Not is connected to everything in Cands. Just give up now!
-			}
-		}
-		const list_of_ints :: const_iterator cands_end = Candidates.get().end();
-		for(list_of_ints :: const_iterator i = Candidates.get().begin(); i != cands_end; i++) {
-			V v = *i;
-			const int currentDiscs = count_disconnections(cands, v, g);
-			if(currentDiscs < fewestDisc) {
-				fewestDisc = currentDiscs;
-				fewestDiscVertex = v;
-				fewestIsInCands = true;
-				if(!fewestIsInCands && fewestDisc==0) return; // something in Not is connected to everything in Cands. Just give up now!
+		assert(f.moved.empty());
+		const int32_t num_cands = int32_t(Candidates.size());
+		int32_t most_connections = -1;
+		for(int pass = 0; pass < 2; pass++) { // Not first, so that we can give up early
+			const bool inCands = pass == 1;
+			const vector<V> &nodes = inCands ? Candidates : f.Not;
+			const vector<V> :: const_iterator nodes_end = nodes.end();
+			for(vector<V> :: const_iterator i = nodes.begin(); i != nodes_end; i++) {
+				V v = *i;
+				const Neighbours v_neighs = s.g->neighbours(v);
+				int32_t &known_bound = s.connections_bound.at(v);
+				int32_t bound = known_bound;
+				if(bound > num_cands)
+					bound = num_cands;
+				if(bound > int32_t(v_neighs.size()))
+					bound = int32_t(v_neighs.size());
+				if(bound <= most_connections)
+					continue;
+				const int32_t connections = count_connections(Candidates, v_neighs, most_connections);
+				s.tighten_connections_bound(v, known_bound, connections);
+				if(connections > most_connections) {
+					most_connections = connections;
+					fewestDisc = num_cands - connections;
+					fewestDiscVertex = v;
+					fewestIsInCands = inCands;
+					if(connections == num_cands) // nothing can beat this.
+						return; // If it's in Not, it's connected to everything in Cands. The caller will just give up now!
+				}
 			}
 		}
 		assert(fewestDisc <= int(Candidates.size()));
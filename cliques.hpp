@@ -3,13 +3,56 @@
 
 
 #include "graph/network.hpp"
+#include "graph_view.hpp"
+#include "relabel.hpp"
+#include "compiled_graph.hpp"
 
 typedef const graph :: VerySimpleGraphInterface * SimpleIntGraph;
 
 namespace cliques {
 
-void cliquesToStdout          (const graph :: NetworkInterfaceConvertedToString * net, unsigned int minimumSize); // You're not allowed to ask for the 2-cliques
-void cliquesToVector          (const graph :: NetworkInterfaceConvertedToString * net, unsigned int minimumSize, std :: vector< std :: vector<int32_t> > & ); // You're not allowed to ask for the 2-cliques
+struct SearchOptions {
+	int num_threads; // > 1 spreads the root vertices over a work-stealing pool, and splits the big roots once the others are done. The cliques found are the same, but the order differs.
+	bool degeneracy_order; // split each root's neighbours into Not/Candidates by degeneracy order, instead of by node id
+	bool truss; // search only the k-truss (k is the minimum size), dropping the edges in fewer than k-2 triangles first. The cliques found are the same
+	int shard, num_shards; // find only the cliques of shard 'shard' of 0 ... num_shards-1 (see shard.hpp). num_shards == 0 means there's no sharding
+	const char *root_report; // if not NULL, write the root_report_top roots that took longest to this file (see root_report.hpp)
+	                         // With threads, a root's subtrees that were split off to other threads aren't counted in its cost
+	size_t root_report_top;
+	relabel :: Order relabel; // renumber the nodes, for locality, before searching. The cliques found are the same, in the original ids
+	bool csr; // search a graph_view :: CsrGraph copy of the network (or of its truss), rather than the network's own lists. A relabeled or compiled graph is one already
+	bool adjacency_index; // build a graph_view :: AdjacencyIndex for are_connected(). It only helps list-engine frames too big for the bitset kernel, and can cost more memory than the graph itself
+	SearchOptions() : num_threads(1), degeneracy_order(false), truss(false), shard(0), num_shards(0), root_report(NULL), root_report_top(100), relabel(relabel :: NONE), csr(false), adjacency_index(false) {}
+};
+
+struct OutputOptions { // where cliquesToStdout writes, and how it checkpoints (see checkpoint.hpp)
+	const char *output_file; // NULL for stdout
+	const char *checkpoint_file; // NULL for no checkpoints. Needs an output_file, as resuming truncates it
+	int checkpoint_seconds;
+	bool resume; // carry on from the checkpoint_file, if there is one, appending to the output_file
+	// with options.num_shards, the output ends with a shard :: Trailer, once the shard is complete
+	OutputOptions() : output_file(NULL), checkpoint_file(NULL), checkpoint_seconds(300), resume(false) {}
+};
+
+void cliquesToStdout          (const compiled_graph :: Input &input, unsigned int minimumSize, const SearchOptions &options = SearchOptions(), const OutputOptions &output = OutputOptions()); // You're not allowed to ask for the 2-cliques
+void cliquesCountOnly         (const compiled_graph :: Input &input, unsigned int minimumSize, const SearchOptions &options = SearchOptions()); // Just the histogram of clique sizes, on stderr, as cliquesToStdout prints it
+void cliquesToVector          (const compiled_graph :: Input &input, unsigned int minimumSize, std :: vector< std :: vector<int32_t> > &, const SearchOptions &options = SearchOptions()); // You're not allowed to ask for the 2-cliques
+
+void cliquesTopToVector       (const compiled_graph :: Input &input, unsigned int minimumSize, size_t N, std :: vector< std :: vector<int32_t> > &, const SearchOptions &options = SearchOptions()); // The N biggest maximal cliques, biggest first. Ties are broken arbitrarily
+
+/*
+ * The maximal cliques, of at least minimumSize, that contain at least one of 'nodes'. Each is found once.
+ * Apart from O(numNodes) to set up, this costs time in proportion to the neighbourhoods of 'nodes', not to the whole graph.
+ * (It's what incremental.cpp uses to re-enumerate around changed edges.)
+ */
+void cliquesAroundNodesToVector(const graph_view :: Graph *g, const std :: vector<int32_t> &nodes, unsigned int minimumSize, std :: vector< std :: vector<int32_t> > &, const SearchOptions &options = SearchOptions());
+
+/*
+ * Just one clique of the largest size, sorted by node id. Branch and bound with greedy coloring bounds (see maximum.cpp).
+ * Uses options.num_threads; it always roots the search in degeneracy order.
+ */
+void maximumClique            (const graph_view :: Graph *g, std :: vector<int32_t> &clique, const SearchOptions &options = SearchOptions());
+void maximumClique            (SimpleIntGraph g, std :: vector<int32_t> &clique, const SearchOptions &options = SearchOptions());
 
 } // namespace cliques
 
@@ -28,18 +28,26 @@ const char *gengetopt_args_info_usage = "Usage: Usage: cp5 [OPTIONS]... edge_lis
 const char *gengetopt_args_info_description = "";
 
 const char *gengetopt_args_info_help[] = {
-  "  -h, --help           Print help and exit",
-  "  -V, --version        Print version and exit",
-  "  -k, --k=INT          minimum size of clique, k. Must be at least 3.  \n                         (default=`3')",
-  "  -K, --K=INT          max k of interest. default is to do all k.      \n                         (default=`-1')",
-  "      --stringIDs      string IDs in the input  (default=off)",
-  "      --rebuild.bloom  rebuild bloom filter occasionally  (default=off)",
-  "      --comments       detailed version description  (default=off)",
+  "  -h, --help             Print help and exit",
+  "  -V, --version          Print version and exit",
+  "  -k, --k=INT            minimum size of clique, k. Must be at least 3.  \n                           (default=`3')",
+  "  -K, --K=INT            max k of interest. default is to do all k.      \n                           (default=`-1')",
+  "      --stringIDs        string IDs in the input  (default=off)",
+  "      --threads=INT      threads to search for cliques with  (default=`1')",
+  "      --degeneracy       root the search in degeneracy order  (default=off)",
+  "      --truss            drop the edges in fewer than k-2 triangles before \n                           searching  (default=off)",
+  "      --relabel=STRING   renumber the nodes before searching: none, degree, rcm \n                           or bfs  (default=`none')",
+  "      --csr              copy the graph into one compressed sparse row array \n                           before searching  (default=off)",
+  "      --adjacency-index  index every edge, for constant-time adjacency tests in \n                           big frames. Costs up to 16 bytes an edge  \n                           (default=off)",
+  "      --parallel-load    parse the edge list with --threads threads, instead of \n                           with lib_graph  (default=off)",
+  "      --rebuild.bloom    rebuild bloom filter occasionally  (default=off)",
+  "      --comments         detailed version description  (default=off)",
     0
 };
 
 typedef enum {ARG_NO
   , ARG_FLAG
+  , ARG_STRING
   , ARG_INT
 } cmdline_parser_arg_type;
 
@@ -64,6 +72,13 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->k_given = 0 ;
   args_info->K_given = 0 ;
   args_info->stringIDs_given = 0 ;
+  args_info->threads_given = 0 ;
+  args_info->degeneracy_given = 0 ;
+  args_info->truss_given = 0 ;
+  args_info->relabel_given = 0 ;
+  args_info->csr_given = 0 ;
+  args_info->adjacency_index_given = 0 ;
+  args_info->parallel_load_given = 0 ;
   args_info->rebuild_bloom_given = 0 ;
   args_info->comments_given = 0 ;
 }
@@ -76,6 +91,15 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->K_arg = -1;
   args_info->K_orig = NULL;
   args_info->stringIDs_flag = 0;
+  args_info->threads_arg = 1;
+  args_info->threads_orig = NULL;
+  args_info->degeneracy_flag = 0;
+  args_info->truss_flag = 0;
+  args_info->relabel_arg = gengetopt_strdup ("none");
+  args_info->relabel_orig = NULL;
+  args_info->csr_flag = 0;
+  args_info->adjacency_index_flag = 0;
+  args_info->parallel_load_flag = 0;
   args_info->rebuild_bloom_flag = 0;
   args_info->comments_flag = 0;
   
@@ -91,8 +115,15 @@ void init_args_info(struct gengetopt_args_info *args_info)
   args_info->k_help = gengetopt_args_info_help[2] ;
   args_info->K_help = gengetopt_args_info_help[3] ;
   args_info->stringIDs_help = gengetopt_args_info_help[4] ;
-  args_info->rebuild_bloom_help = gengetopt_args_info_help[5] ;
-  args_info->comments_help = gengetopt_args_info_help[6] ;
+  args_info->threads_help = gengetopt_args_info_help[5] ;
+  args_info->degeneracy_help = gengetopt_args_info_help[6] ;
+  args_info->truss_help = gengetopt_args_info_help[7] ;
+  args_info->relabel_help = gengetopt_args_info_help[8] ;
+  args_info->csr_help = gengetopt_args_info_help[9] ;
+  args_info->adjacency_index_help = gengetopt_args_info_help[10] ;
+  args_info->parallel_load_help = gengetopt_args_info_help[11] ;
+  args_info->rebuild_bloom_help = gengetopt_args_info_help[12] ;
+  args_info->comments_help = gengetopt_args_info_help[13] ;
   
 }
 
@@ -176,6 +207,9 @@ cmdline_parser_release (struct gengetopt_args_info *args_info)
   unsigned int i;
   free_string_field (&(args_info->k_orig));
   free_string_field (&(args_info->K_orig));
+  free_string_field (&(args_info->threads_orig));
+  free_string_field (&(args_info->relabel_arg));
+  free_string_field (&(args_info->relabel_orig));
   
   
   for (i = 0; i < args_info->inputs_num; ++i)
@@ -220,6 +254,20 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "K", args_info->K_orig, 0);
   if (args_info->stringIDs_given)
     write_into_file(outfile, "stringIDs", 0, 0 );
+  if (args_info->threads_given)
+    write_into_file(outfile, "threads", args_info->threads_orig, 0);
+  if (args_info->degeneracy_given)
+    write_into_file(outfile, "degeneracy", 0, 0 );
+  if (args_info->truss_given)
+    write_into_file(outfile, "truss", 0, 0 );
+  if (args_info->relabel_given)
+    write_into_file(outfile, "relabel", args_info->relabel_orig, 0);
+  if (args_info->csr_given)
+    write_into_file(outfile, "csr", 0, 0 );
+  if (args_info->adjacency_index_given)
+    write_into_file(outfile, "adjacency-index", 0, 0 );
+  if (args_info->parallel_load_given)
+    write_into_file(outfile, "parallel-load", 0, 0 );
   if (args_info->rebuild_bloom_given)
     write_into_file(outfile, "rebuild.bloom", 0, 0 );
   if (args_info->comments_given)
@@ -356,6 +404,7 @@ int update_arg(void *field, char **orig_field,
   char *stop_char = 0;
   const char *val = value;
   int found;
+  char **string_field;
 
   stop_char = 0;
   found = 0;
@@ -387,6 +436,14 @@ int update_arg(void *field, char **orig_field,
   case ARG_FLAG:
     *((int *)field) = !*((int *)field);
     break;
+  case ARG_STRING:
+    if (val) {
+      string_field = (char **)field;
+      if (!no_free && *string_field)
+        free (*string_field); /* free previous string */
+      *string_field = gengetopt_strdup (val);
+    }
+    break;
   case ARG_INT:
     if (val) *((int *)field) = strtol (val, &stop_char, 0);
     break;
@@ -468,6 +525,13 @@ cmdline_parser_internal (int argc, char * const *argv, struct gengetopt_args_inf
         { "k",	1, NULL, 'k' },
         { "K",	1, NULL, 'K' },
         { "stringIDs",	0, NULL, 0 },
+        { "threads",	1, NULL, 0 },
+        { "degeneracy",	0, NULL, 0 },
+        { "truss",	0, NULL, 0 },
+        { "relabel",	1, NULL, 0 },
+        { "csr",	0, NULL, 0 },
+        { "adjacency-index",	0, NULL, 0 },
+        { "parallel-load",	0, NULL, 0 },
         { "rebuild.bloom",	0, NULL, 0 },
         { "comments",	0, NULL, 0 },
         { NULL,	0, NULL, 0 }
@@ -526,6 +590,94 @@ cmdline_parser_internal (int argc, char * const *argv, struct gengetopt_args_inf
                 additional_error))
               goto failure;
           
+          }
+          /* threads to search for cliques with.  */
+          else if (strcmp (long_options[option_index].name, "threads") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->threads_arg), 
+                 &(args_info->threads_orig), &(args_info->threads_given),
+                &(local_args_info.threads_given), optarg, 0, "1", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "threads", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* root the search in degeneracy order.  */
+          else if (strcmp (long_options[option_index].name, "degeneracy") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->degeneracy_flag), 0, &(args_info->degeneracy_given),
+                &(local_args_info.degeneracy_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "degeneracy", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* drop the edges in fewer than k-2 triangles before searching.  */
+          else if (strcmp (long_options[option_index].name, "truss") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->truss_flag), 0, &(args_info->truss_given),
+                &(local_args_info.truss_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "truss", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* renumber the nodes before searching: none, degree, rcm or bfs.  */
+          else if (strcmp (long_options[option_index].name, "relabel") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->relabel_arg), 
+                 &(args_info->relabel_orig), &(args_info->relabel_given),
+                &(local_args_info.relabel_given), optarg, 0, "none", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "relabel", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* copy the graph into one compressed sparse row array before searching.  */
+          else if (strcmp (long_options[option_index].name, "csr") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->csr_flag), 0, &(args_info->csr_given),
+                &(local_args_info.csr_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "csr", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* index every edge, for constant-time adjacency tests in big frames. Costs up to 16 bytes an edge.  */
+          else if (strcmp (long_options[option_index].name, "adjacency-index") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->adjacency_index_flag), 0, &(args_info->adjacency_index_given),
+                &(local_args_info.adjacency_index_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "adjacency-index", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* parse the edge list with --threads threads, instead of with lib_graph.  */
+          else if (strcmp (long_options[option_index].name, "parallel-load") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->parallel_load_flag), 0, &(args_info->parallel_load_given),
+                &(local_args_info.parallel_load_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "parallel-load", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* rebuild bloom filter occasionally.  */
           else if (strcmp (long_options[option_index].name, "rebuild.bloom") == 0)
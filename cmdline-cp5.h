@@ -42,6 +42,22 @@ struct gengetopt_args_info
   const char *K_help; /**< @brief max k of interest. default is to do all k.     help description.  */
   int stringIDs_flag;	/**< @brief string IDs in the input (default=off).  */
   const char *stringIDs_help; /**< @brief string IDs in the input help description.  */
+  int threads_arg;	/**< @brief threads to search for cliques with (default='1').  */
+  char * threads_orig;	/**< @brief threads to search for cliques with original value given at command line.  */
+  const char *threads_help; /**< @brief threads to search for cliques with help description.  */
+  int degeneracy_flag;	/**< @brief root the search in degeneracy order (default=off).  */
+  const char *degeneracy_help; /**< @brief root the search in degeneracy order help description.  */
+  int truss_flag;	/**< @brief drop the edges in fewer than k-2 triangles before searching (default=off).  */
+  const char *truss_help; /**< @brief drop the edges in fewer than k-2 triangles before searching help description.  */
+  char * relabel_arg;	/**< @brief renumber the nodes before searching: none, degree, rcm or bfs (default='none').  */
+  char * relabel_orig;	/**< @brief renumber the nodes before searching: none, degree, rcm or bfs original value given at command line.  */
+  const char *relabel_help; /**< @brief renumber the nodes before searching: none, degree, rcm or bfs help description.  */
+  int csr_flag;	/**< @brief copy the graph into one compressed sparse row array before searching (default=off).  */
+  const char *csr_help; /**< @brief copy the graph into one compressed sparse row array before searching help description.  */
+  int adjacency_index_flag;	/**< @brief index every edge, for constant-time adjacency tests in big frames. Costs up to 16 bytes an edge (default=off).  */
+  const char *adjacency_index_help; /**< @brief index every edge, for constant-time adjacency tests in big frames. Costs up to 16 bytes an edge help description.  */
+  int parallel_load_flag;	/**< @brief parse the edge list with --threads threads, instead of with lib_graph (default=off).  */
+  const char *parallel_load_help; /**< @brief parse the edge list with --threads threads, instead of with lib_graph help description.  */
   int rebuild_bloom_flag;	/**< @brief rebuild bloom filter occasionally (default=off).  */
   const char *rebuild_bloom_help; /**< @brief rebuild bloom filter occasionally help description.  */
   int comments_flag;	/**< @brief detailed version description (default=off).  */
@@ -52,6 +68,13 @@ struct gengetopt_args_info
   unsigned int k_given ;	/**< @brief Whether k was given.  */
   unsigned int K_given ;	/**< @brief Whether K was given.  */
   unsigned int stringIDs_given ;	/**< @brief Whether stringIDs was given.  */
+  unsigned int threads_given ;	/**< @brief Whether threads was given.  */
+  unsigned int degeneracy_given ;	/**< @brief Whether degeneracy was given.  */
+  unsigned int truss_given ;	/**< @brief Whether truss was given.  */
+  unsigned int relabel_given ;	/**< @brief Whether relabel was given.  */
+  unsigned int csr_given ;	/**< @brief Whether csr was given.  */
+  unsigned int adjacency_index_given ;	/**< @brief Whether adjacency-index was given.  */
+  unsigned int parallel_load_given ;	/**< @brief Whether parallel-load was given.  */
   unsigned int rebuild_bloom_given ;	/**< @brief Whether rebuild.bloom was given.  */
   unsigned int comments_given ;	/**< @brief Whether comments was given.  */
 
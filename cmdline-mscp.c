@@ -28,16 +28,19 @@ const char *gengetopt_args_info_usage = "Usage: Usage: mscp [OPTIONS]... edge_li
 const char *gengetopt_args_info_description = "";
 
 const char *gengetopt_args_info_help[] = {
-  "  -h, --help       Print help and exit",
-  "  -V, --version    Print version and exit",
-  "  -k, --k=INT      size of clique to percolate. Must be at least 3.  \n                     (default=`3')",
-  "      --stringIDs  string IDs in the input  (default=off)",
-  "      --comments   detailed version description  (default=off)",
+  "  -h, --help            Print help and exit",
+  "  -V, --version         Print version and exit",
+  "  -k, --k=INT           size of clique to percolate. Must be at least 3.  \n                          (default=`3')",
+  "      --stringIDs       string IDs in the input  (default=off)",
+  "      --comments        detailed version description  (default=off)",
+  "      --relabel=STRING  renumber the nodes before searching: none, degree, rcm \n                          or bfs  (default=`none')",
+  "      --csr             copy the graph into one compressed sparse row array \n                          before searching  (default=off)",
     0
 };
 
 typedef enum {ARG_NO
   , ARG_FLAG
+  , ARG_STRING
   , ARG_INT
 } cmdline_parser_arg_type;
 
@@ -62,6 +65,8 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->k_given = 0 ;
   args_info->stringIDs_given = 0 ;
   args_info->comments_given = 0 ;
+  args_info->relabel_given = 0 ;
+  args_info->csr_given = 0 ;
 }
 
 static
@@ -71,6 +76,9 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->k_orig = NULL;
   args_info->stringIDs_flag = 0;
   args_info->comments_flag = 0;
+  args_info->relabel_arg = gengetopt_strdup ("none");
+  args_info->relabel_orig = NULL;
+  args_info->csr_flag = 0;
   
 }
 
@@ -84,6 +92,8 @@ void init_args_info(struct gengetopt_args_info *args_info)
   args_info->k_help = gengetopt_args_info_help[2] ;
   args_info->stringIDs_help = gengetopt_args_info_help[3] ;
   args_info->comments_help = gengetopt_args_info_help[4] ;
+  args_info->relabel_help = gengetopt_args_info_help[5] ;
+  args_info->csr_help = gengetopt_args_info_help[6] ;
   
 }
 
@@ -166,6 +176,8 @@ cmdline_parser_release (struct gengetopt_args_info *args_info)
 {
   unsigned int i;
   free_string_field (&(args_info->k_orig));
+  free_string_field (&(args_info->relabel_arg));
+  free_string_field (&(args_info->relabel_orig));
   
   
   for (i = 0; i < args_info->inputs_num; ++i)
@@ -210,6 +222,10 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "stringIDs", 0, 0 );
   if (args_info->comments_given)
     write_into_file(outfile, "comments", 0, 0 );
+  if (args_info->relabel_given)
+    write_into_file(outfile, "relabel", args_info->relabel_orig, 0);
+  if (args_info->csr_given)
+    write_into_file(outfile, "csr", 0, 0 );
   
 
   i = EXIT_SUCCESS;
@@ -342,6 +358,7 @@ int update_arg(void *field, char **orig_field,
   char *stop_char = 0;
   const char *val = value;
   int found;
+  char **string_field;
 
   stop_char = 0;
   found = 0;
@@ -373,6 +390,14 @@ int update_arg(void *field, char **orig_field,
   case ARG_FLAG:
     *((int *)field) = !*((int *)field);
     break;
+  case ARG_STRING:
+    if (val) {
+      string_field = (char **)field;
+      if (!no_free && *string_field)
+        free (*string_field); /* free previous string */
+      *string_field = gengetopt_strdup (val);
+    }
+    break;
   case ARG_INT:
     if (val) *((int *)field) = strtol (val, &stop_char, 0);
     break;
@@ -454,6 +479,8 @@ cmdline_parser_internal (int argc, char * const *argv, struct gengetopt_args_inf
         { "k",	1, NULL, 'k' },
         { "stringIDs",	0, NULL, 0 },
         { "comments",	0, NULL, 0 },
+        { "relabel",	1, NULL, 0 },
+        { "csr",	0, NULL, 0 },
         { NULL,	0, NULL, 0 }
       };
 
@@ -510,6 +537,32 @@ cmdline_parser_internal (int argc, char * const *argv, struct gengetopt_args_inf
                 additional_error))
               goto failure;
           
+          }
+          /* renumber the nodes before searching: none, degree, rcm or bfs.  */
+          else if (strcmp (long_options[option_index].name, "relabel") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->relabel_arg), 
+                 &(args_info->relabel_orig), &(args_info->relabel_given),
+                &(local_args_info.relabel_given), optarg, 0, "none", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "relabel", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* copy the graph into one compressed sparse row array before searching.  */
+          else if (strcmp (long_options[option_index].name, "csr") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->csr_flag), 0, &(args_info->csr_given),
+                &(local_args_info.csr_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "csr", '-',
+                additional_error))
+              goto failure;
+          
           }
           
           break;
@@ -41,12 +41,19 @@ struct gengetopt_args_info
   const char *stringIDs_help; /**< @brief string IDs in the input help description.  */
   int comments_flag;	/**< @brief detailed version description (default=off).  */
   const char *comments_help; /**< @brief detailed version description help description.  */
+  char * relabel_arg;	/**< @brief renumber the nodes before searching: none, degree, rcm or bfs (default='none').  */
+  char * relabel_orig;	/**< @brief renumber the nodes before searching: none, degree, rcm or bfs original value given at command line.  */
+  const char *relabel_help; /**< @brief renumber the nodes before searching: none, degree, rcm or bfs help description.  */
+  int csr_flag;	/**< @brief copy the graph into one compressed sparse row array before searching (default=off).  */
+  const char *csr_help; /**< @brief copy the graph into one compressed sparse row array before searching help description.  */
   
   unsigned int help_given ;	/**< @brief Whether help was given.  */
   unsigned int version_given ;	/**< @brief Whether version was given.  */
   unsigned int k_given ;	/**< @brief Whether k was given.  */
   unsigned int stringIDs_given ;	/**< @brief Whether stringIDs was given.  */
   unsigned int comments_given ;	/**< @brief Whether comments was given.  */
+  unsigned int relabel_given ;	/**< @brief Whether relabel was given.  */
+  unsigned int csr_given ;	/**< @brief Whether csr was given.  */
 
   char **inputs ; /**< @brief unamed options (options without names) */
   unsigned inputs_num ; /**< @brief unamed options number */
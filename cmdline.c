@@ -28,15 +28,33 @@ const char *gengetopt_args_info_usage = "Usage: Find Maximal Cliques [OPTIONS]..
 const char *gengetopt_args_info_description = "";
 
 const char *gengetopt_args_info_help[] = {
-  "  -h, --help       Print help and exit",
-  "  -V, --version    Print version and exit",
-  "  -k, --k=INT      minimum size of clique, k. Must be at least 3.  \n                     (default=`3')",
-  "      --stringIDs  string IDs in the input  (default=off)",
+  "  -h, --help                    Print help and exit",
+  "  -V, --version                 Print version and exit",
+  "  -k, --k=INT                   minimum size of clique, k. Must be at least 3.  \n                                  (default=`3')",
+  "      --stringIDs               string IDs in the input  (default=off)",
+  "      --threads=INT             threads to search for cliques with  \n                                  (default=`1')",
+  "      --degeneracy              root the search in degeneracy order  \n                                  (default=off)",
+  "      --truss                   drop the edges in fewer than k-2 triangles \n                                  before searching  (default=off)",
+  "      --relabel=STRING          renumber the nodes before searching: none, \n                                  degree, rcm or bfs  (default=`none')",
+  "      --csr                     copy the graph into one compressed sparse row \n                                  array before searching  (default=off)",
+  "      --adjacency-index         index every edge, for constant-time adjacency \n                                  tests in big frames. Costs up to 16 bytes an \n                                  edge  (default=off)",
+  "      --parallel-load           parse the edge list with --threads threads, \n                                  instead of with lib_graph  (default=off)",
+  "      --count-only              don't print the cliques, just count them by \n                                  size  (default=off)",
+  "      --maximum                 print just one maximum clique  (default=off)",
+  "      --top=INT                 print just the N biggest cliques  (default=`0')",
+  "  -o, --output=STRING           write the cliques to this file, instead of to \n                                  stdout",
+  "      --checkpoint=STRING       save the progress to this file now and then \n                                  (needs --output)",
+  "      --checkpoint-seconds=INT  how often to save the progress  (default=`300')",
+  "      --resume                  carry on from the --checkpoint, if there is one  \n                                  (default=off)",
+  "      --shard=STRING            find just the cliques of shard i/n, for 0 <= i \n                                  < n (see mergeShards)",
+  "      --root-report=STRING      write the roots that took longest to search, \n                                  with their names and degrees, to this file",
+  "      --root-report-top=INT     how many roots to put in the --root-report  \n                                  (default=`100')",
     0
 };
 
 typedef enum {ARG_NO
   , ARG_FLAG
+  , ARG_STRING
   , ARG_INT
 } cmdline_parser_arg_type;
 
@@ -60,6 +78,23 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->version_given = 0 ;
   args_info->k_given = 0 ;
   args_info->stringIDs_given = 0 ;
+  args_info->threads_given = 0 ;
+  args_info->degeneracy_given = 0 ;
+  args_info->truss_given = 0 ;
+  args_info->relabel_given = 0 ;
+  args_info->csr_given = 0 ;
+  args_info->adjacency_index_given = 0 ;
+  args_info->parallel_load_given = 0 ;
+  args_info->count_only_given = 0 ;
+  args_info->maximum_given = 0 ;
+  args_info->top_given = 0 ;
+  args_info->output_given = 0 ;
+  args_info->checkpoint_given = 0 ;
+  args_info->checkpoint_seconds_given = 0 ;
+  args_info->resume_given = 0 ;
+  args_info->shard_given = 0 ;
+  args_info->root_report_given = 0 ;
+  args_info->root_report_top_given = 0 ;
 }
 
 static
@@ -68,6 +103,32 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->k_arg = 3;
   args_info->k_orig = NULL;
   args_info->stringIDs_flag = 0;
+  args_info->threads_arg = 1;
+  args_info->threads_orig = NULL;
+  args_info->degeneracy_flag = 0;
+  args_info->truss_flag = 0;
+  args_info->relabel_arg = gengetopt_strdup ("none");
+  args_info->relabel_orig = NULL;
+  args_info->csr_flag = 0;
+  args_info->adjacency_index_flag = 0;
+  args_info->parallel_load_flag = 0;
+  args_info->count_only_flag = 0;
+  args_info->maximum_flag = 0;
+  args_info->top_arg = 0;
+  args_info->top_orig = NULL;
+  args_info->output_arg = NULL;
+  args_info->output_orig = NULL;
+  args_info->checkpoint_arg = NULL;
+  args_info->checkpoint_orig = NULL;
+  args_info->checkpoint_seconds_arg = 300;
+  args_info->checkpoint_seconds_orig = NULL;
+  args_info->resume_flag = 0;
+  args_info->shard_arg = NULL;
+  args_info->shard_orig = NULL;
+  args_info->root_report_arg = NULL;
+  args_info->root_report_orig = NULL;
+  args_info->root_report_top_arg = 100;
+  args_info->root_report_top_orig = NULL;
   
 }
 
@@ -80,6 +141,23 @@ void init_args_info(struct gengetopt_args_info *args_info)
   args_info->version_help = gengetopt_args_info_help[1] ;
   args_info->k_help = gengetopt_args_info_help[2] ;
   args_info->stringIDs_help = gengetopt_args_info_help[3] ;
+  args_info->threads_help = gengetopt_args_info_help[4] ;
+  args_info->degeneracy_help = gengetopt_args_info_help[5] ;
+  args_info->truss_help = gengetopt_args_info_help[6] ;
+  args_info->relabel_help = gengetopt_args_info_help[7] ;
+  args_info->csr_help = gengetopt_args_info_help[8] ;
+  args_info->adjacency_index_help = gengetopt_args_info_help[9] ;
+  args_info->parallel_load_help = gengetopt_args_info_help[10] ;
+  args_info->count_only_help = gengetopt_args_info_help[11] ;
+  args_info->maximum_help = gengetopt_args_info_help[12] ;
+  args_info->top_help = gengetopt_args_info_help[13] ;
+  args_info->output_help = gengetopt_args_info_help[14] ;
+  args_info->checkpoint_help = gengetopt_args_info_help[15] ;
+  args_info->checkpoint_seconds_help = gengetopt_args_info_help[16] ;
+  args_info->resume_help = gengetopt_args_info_help[17] ;
+  args_info->shard_help = gengetopt_args_info_help[18] ;
+  args_info->root_report_help = gengetopt_args_info_help[19] ;
+  args_info->root_report_top_help = gengetopt_args_info_help[20] ;
   
 }
 
@@ -162,6 +240,20 @@ cmdline_parser_release (struct gengetopt_args_info *args_info)
 {
   unsigned int i;
   free_string_field (&(args_info->k_orig));
+  free_string_field (&(args_info->threads_orig));
+  free_string_field (&(args_info->relabel_arg));
+  free_string_field (&(args_info->relabel_orig));
+  free_string_field (&(args_info->top_orig));
+  free_string_field (&(args_info->output_arg));
+  free_string_field (&(args_info->output_orig));
+  free_string_field (&(args_info->checkpoint_arg));
+  free_string_field (&(args_info->checkpoint_orig));
+  free_string_field (&(args_info->checkpoint_seconds_orig));
+  free_string_field (&(args_info->shard_arg));
+  free_string_field (&(args_info->shard_orig));
+  free_string_field (&(args_info->root_report_arg));
+  free_string_field (&(args_info->root_report_orig));
+  free_string_field (&(args_info->root_report_top_orig));
   
   
   for (i = 0; i < args_info->inputs_num; ++i)
@@ -204,6 +296,40 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "k", args_info->k_orig, 0);
   if (args_info->stringIDs_given)
     write_into_file(outfile, "stringIDs", 0, 0 );
+  if (args_info->threads_given)
+    write_into_file(outfile, "threads", args_info->threads_orig, 0);
+  if (args_info->degeneracy_given)
+    write_into_file(outfile, "degeneracy", 0, 0 );
+  if (args_info->truss_given)
+    write_into_file(outfile, "truss", 0, 0 );
+  if (args_info->relabel_given)
+    write_into_file(outfile, "relabel", args_info->relabel_orig, 0);
+  if (args_info->csr_given)
+    write_into_file(outfile, "csr", 0, 0 );
+  if (args_info->adjacency_index_given)
+    write_into_file(outfile, "adjacency-index", 0, 0 );
+  if (args_info->parallel_load_given)
+    write_into_file(outfile, "parallel-load", 0, 0 );
+  if (args_info->count_only_given)
+    write_into_file(outfile, "count-only", 0, 0 );
+  if (args_info->maximum_given)
+    write_into_file(outfile, "maximum", 0, 0 );
+  if (args_info->top_given)
+    write_into_file(outfile, "top", args_info->top_orig, 0);
+  if (args_info->output_given)
+    write_into_file(outfile, "output", args_info->output_orig, 0);
+  if (args_info->checkpoint_given)
+    write_into_file(outfile, "checkpoint", args_info->checkpoint_orig, 0);
+  if (args_info->checkpoint_seconds_given)
+    write_into_file(outfile, "checkpoint-seconds", args_info->checkpoint_seconds_orig, 0);
+  if (args_info->resume_given)
+    write_into_file(outfile, "resume", 0, 0 );
+  if (args_info->shard_given)
+    write_into_file(outfile, "shard", args_info->shard_orig, 0);
+  if (args_info->root_report_given)
+    write_into_file(outfile, "root-report", args_info->root_report_orig, 0);
+  if (args_info->root_report_top_given)
+    write_into_file(outfile, "root-report-top", args_info->root_report_top_orig, 0);
   
 
   i = EXIT_SUCCESS;
@@ -336,6 +462,7 @@ int update_arg(void *field, char **orig_field,
   char *stop_char = 0;
   const char *val = value;
   int found;
+  char **string_field;
 
   stop_char = 0;
   found = 0;
@@ -367,6 +494,14 @@ int update_arg(void *field, char **orig_field,
   case ARG_FLAG:
     *((int *)field) = !*((int *)field);
     break;
+  case ARG_STRING:
+    if (val) {
+      string_field = (char **)field;
+      if (!no_free && *string_field)
+        free (*string_field); /* free previous string */
+      *string_field = gengetopt_strdup (val);
+    }
+    break;
   case ARG_INT:
     if (val) *((int *)field) = strtol (val, &stop_char, 0);
     break;
@@ -447,10 +582,27 @@ cmdline_parser_internal (int argc, char * const *argv, struct gengetopt_args_inf
         { "version",	0, NULL, 'V' },
         { "k",	1, NULL, 'k' },
         { "stringIDs",	0, NULL, 0 },
+        { "threads",	1, NULL, 0 },
+        { "degeneracy",	0, NULL, 0 },
+        { "truss",	0, NULL, 0 },
+        { "relabel",	1, NULL, 0 },
+        { "csr",	0, NULL, 0 },
+        { "adjacency-index",	0, NULL, 0 },
+        { "parallel-load",	0, NULL, 0 },
+        { "count-only",	0, NULL, 0 },
+        { "maximum",	0, NULL, 0 },
+        { "top",	1, NULL, 0 },
+        { "output",	1, NULL, 'o' },
+        { "checkpoint",	1, NULL, 0 },
+        { "checkpoint-seconds",	1, NULL, 0 },
+        { "resume",	0, NULL, 0 },
+        { "shard",	1, NULL, 0 },
+        { "root-report",	1, NULL, 0 },
+        { "root-report-top",	1, NULL, 0 },
         { NULL,	0, NULL, 0 }
       };
 
-      c = getopt_long (argc, argv, "hVk:", long_options, &option_index);
+      c = getopt_long (argc, argv, "hVk:o:", long_options, &option_index);
 
       if (c == -1) break;	/* Exit from `while (1)' loop.  */
 
@@ -478,6 +630,18 @@ cmdline_parser_internal (int argc, char * const *argv, struct gengetopt_args_inf
             goto failure;
         
           break;
+        case 'o':	/* write the cliques to this file, instead of to stdout.  */
+        
+        
+          if (update_arg( (void *)&(args_info->output_arg), 
+               &(args_info->output_orig), &(args_info->output_given),
+              &(local_args_info.output_given), optarg, 0, 0, ARG_STRING,
+              check_ambiguity, override, 0, 0,
+              "output", 'o',
+              additional_error))
+            goto failure;
+        
+          break;
 
         case 0:	/* Long option with no short option */
           /* string IDs in the input.  */
@@ -491,6 +655,214 @@ cmdline_parser_internal (int argc, char * const *argv, struct gengetopt_args_inf
                 additional_error))
               goto failure;
           
+          }
+          /* threads to search for cliques with.  */
+          else if (strcmp (long_options[option_index].name, "threads") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->threads_arg), 
+                 &(args_info->threads_orig), &(args_info->threads_given),
+                &(local_args_info.threads_given), optarg, 0, "1", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "threads", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* root the search in degeneracy order.  */
+          else if (strcmp (long_options[option_index].name, "degeneracy") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->degeneracy_flag), 0, &(args_info->degeneracy_given),
+                &(local_args_info.degeneracy_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "degeneracy", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* drop the edges in fewer than k-2 triangles before searching.  */
+          else if (strcmp (long_options[option_index].name, "truss") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->truss_flag), 0, &(args_info->truss_given),
+                &(local_args_info.truss_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "truss", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* renumber the nodes before searching: none, degree, rcm or bfs.  */
+          else if (strcmp (long_options[option_index].name, "relabel") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->relabel_arg), 
+                 &(args_info->relabel_orig), &(args_info->relabel_given),
+                &(local_args_info.relabel_given), optarg, 0, "none", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "relabel", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* copy the graph into one compressed sparse row array before searching.  */
+          else if (strcmp (long_options[option_index].name, "csr") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->csr_flag), 0, &(args_info->csr_given),
+                &(local_args_info.csr_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "csr", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* index every edge, for constant-time adjacency tests in big frames. Costs up to 16 bytes an edge.  */
+          else if (strcmp (long_options[option_index].name, "adjacency-index") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->adjacency_index_flag), 0, &(args_info->adjacency_index_given),
+                &(local_args_info.adjacency_index_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "adjacency-index", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* parse the edge list with --threads threads, instead of with lib_graph.  */
+          else if (strcmp (long_options[option_index].name, "parallel-load") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->parallel_load_flag), 0, &(args_info->parallel_load_given),
+                &(local_args_info.parallel_load_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "parallel-load", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* don't print the cliques, just count them by size.  */
+          else if (strcmp (long_options[option_index].name, "count-only") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->count_only_flag), 0, &(args_info->count_only_given),
+                &(local_args_info.count_only_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "count-only", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* print just one maximum clique.  */
+          else if (strcmp (long_options[option_index].name, "maximum") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->maximum_flag), 0, &(args_info->maximum_given),
+                &(local_args_info.maximum_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "maximum", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* print just the N biggest cliques.  */
+          else if (strcmp (long_options[option_index].name, "top") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->top_arg), 
+                 &(args_info->top_orig), &(args_info->top_given),
+                &(local_args_info.top_given), optarg, 0, "0", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "top", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* save the progress to this file now and then (needs --output).  */
+          else if (strcmp (long_options[option_index].name, "checkpoint") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->checkpoint_arg), 
+                 &(args_info->checkpoint_orig), &(args_info->checkpoint_given),
+                &(local_args_info.checkpoint_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "checkpoint", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* how often to save the progress.  */
+          else if (strcmp (long_options[option_index].name, "checkpoint-seconds") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->checkpoint_seconds_arg), 
+                 &(args_info->checkpoint_seconds_orig), &(args_info->checkpoint_seconds_given),
+                &(local_args_info.checkpoint_seconds_given), optarg, 0, "300", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "checkpoint-seconds", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* carry on from the --checkpoint, if there is one.  */
+          else if (strcmp (long_options[option_index].name, "resume") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->resume_flag), 0, &(args_info->resume_given),
+                &(local_args_info.resume_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "resume", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* find just the cliques of shard i/n, for 0 <= i < n (see mergeShards).  */
+          else if (strcmp (long_options[option_index].name, "shard") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->shard_arg), 
+                 &(args_info->shard_orig), &(args_info->shard_given),
+                &(local_args_info.shard_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "shard", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* write the roots that took longest to search, with their names and degrees, to this file.  */
+          else if (strcmp (long_options[option_index].name, "root-report") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->root_report_arg), 
+                 &(args_info->root_report_orig), &(args_info->root_report_given),
+                &(local_args_info.root_report_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "root-report", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* how many roots to put in the --root-report.  */
+          else if (strcmp (long_options[option_index].name, "root-report-top") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->root_report_top_arg), 
+                 &(args_info->root_report_top_orig), &(args_info->root_report_top_given),
+                &(local_args_info.root_report_top_given), optarg, 0, "100", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "root-report-top", '-',
+                additional_error))
+              goto failure;
+          
           }
           
           break;
@@ -39,11 +39,71 @@ struct gengetopt_args_info
   const char *k_help; /**< @brief minimum size of clique, k. Must be at least 3. help description.  */
   int stringIDs_flag;	/**< @brief string IDs in the input (default=off).  */
   const char *stringIDs_help; /**< @brief string IDs in the input help description.  */
+  int threads_arg;	/**< @brief threads to search for cliques with (default='1').  */
+  char * threads_orig;	/**< @brief threads to search for cliques with original value given at command line.  */
+  const char *threads_help; /**< @brief threads to search for cliques with help description.  */
+  int degeneracy_flag;	/**< @brief root the search in degeneracy order (default=off).  */
+  const char *degeneracy_help; /**< @brief root the search in degeneracy order help description.  */
+  int truss_flag;	/**< @brief drop the edges in fewer than k-2 triangles before searching (default=off).  */
+  const char *truss_help; /**< @brief drop the edges in fewer than k-2 triangles before searching help description.  */
+  char * relabel_arg;	/**< @brief renumber the nodes before searching: none, degree, rcm or bfs (default='none').  */
+  char * relabel_orig;	/**< @brief renumber the nodes before searching: none, degree, rcm or bfs original value given at command line.  */
+  const char *relabel_help; /**< @brief renumber the nodes before searching: none, degree, rcm or bfs help description.  */
+  int csr_flag;	/**< @brief copy the graph into one compressed sparse row array before searching (default=off).  */
+  const char *csr_help; /**< @brief copy the graph into one compressed sparse row array before searching help description.  */
+  int adjacency_index_flag;	/**< @brief index every edge, for constant-time adjacency tests in big frames. Costs up to 16 bytes an edge (default=off).  */
+  const char *adjacency_index_help; /**< @brief index every edge, for constant-time adjacency tests in big frames. Costs up to 16 bytes an edge help description.  */
+  int parallel_load_flag;	/**< @brief parse the edge list with --threads threads, instead of with lib_graph (default=off).  */
+  const char *parallel_load_help; /**< @brief parse the edge list with --threads threads, instead of with lib_graph help description.  */
+  int count_only_flag;	/**< @brief don't print the cliques, just count them by size (default=off).  */
+  const char *count_only_help; /**< @brief don't print the cliques, just count them by size help description.  */
+  int maximum_flag;	/**< @brief print just one maximum clique (default=off).  */
+  const char *maximum_help; /**< @brief print just one maximum clique help description.  */
+  int top_arg;	/**< @brief print just the N biggest cliques (default='0').  */
+  char * top_orig;	/**< @brief print just the N biggest cliques original value given at command line.  */
+  const char *top_help; /**< @brief print just the N biggest cliques help description.  */
+  char * output_arg;	/**< @brief write the cliques to this file, instead of to stdout.  */
+  char * output_orig;	/**< @brief write the cliques to this file, instead of to stdout original value given at command line.  */
+  const char *output_help; /**< @brief write the cliques to this file, instead of to stdout help description.  */
+  char * checkpoint_arg;	/**< @brief save the progress to this file now and then (needs --output).  */
+  char * checkpoint_orig;	/**< @brief save the progress to this file now and then (needs --output) original value given at command line.  */
+  const char *checkpoint_help; /**< @brief save the progress to this file now and then (needs --output) help description.  */
+  int checkpoint_seconds_arg;	/**< @brief how often to save the progress (default='300').  */
+  char * checkpoint_seconds_orig;	/**< @brief how often to save the progress original value given at command line.  */
+  const char *checkpoint_seconds_help; /**< @brief how often to save the progress help description.  */
+  int resume_flag;	/**< @brief carry on from the --checkpoint, if there is one (default=off).  */
+  const char *resume_help; /**< @brief carry on from the --checkpoint, if there is one help description.  */
+  char * shard_arg;	/**< @brief find just the cliques of shard i/n, for 0 <= i < n (see mergeShards).  */
+  char * shard_orig;	/**< @brief find just the cliques of shard i/n, for 0 <= i < n (see mergeShards) original value given at command line.  */
+  const char *shard_help; /**< @brief find just the cliques of shard i/n, for 0 <= i < n (see mergeShards) help description.  */
+  char * root_report_arg;	/**< @brief write the roots that took longest to search, with their names and degrees, to this file.  */
+  char * root_report_orig;	/**< @brief write the roots that took longest to search, with their names and degrees, to this file original value given at command line.  */
+  const char *root_report_help; /**< @brief write the roots that took longest to search, with their names and degrees, to this file help description.  */
+  int root_report_top_arg;	/**< @brief how many roots to put in the --root-report (default='100').  */
+  char * root_report_top_orig;	/**< @brief how many roots to put in the --root-report original value given at command line.  */
+  const char *root_report_top_help; /**< @brief how many roots to put in the --root-report help description.  */
   
   unsigned int help_given ;	/**< @brief Whether help was given.  */
   unsigned int version_given ;	/**< @brief Whether version was given.  */
   unsigned int k_given ;	/**< @brief Whether k was given.  */
   unsigned int stringIDs_given ;	/**< @brief Whether stringIDs was given.  */
+  unsigned int threads_given ;	/**< @brief Whether threads was given.  */
+  unsigned int degeneracy_given ;	/**< @brief Whether degeneracy was given.  */
+  unsigned int truss_given ;	/**< @brief Whether truss was given.  */
+  unsigned int relabel_given ;	/**< @brief Whether relabel was given.  */
+  unsigned int csr_given ;	/**< @brief Whether csr was given.  */
+  unsigned int adjacency_index_given ;	/**< @brief Whether adjacency-index was given.  */
+  unsigned int parallel_load_given ;	/**< @brief Whether parallel-load was given.  */
+  unsigned int count_only_given ;	/**< @brief Whether count-only was given.  */
+  unsigned int maximum_given ;	/**< @brief Whether maximum was given.  */
+  unsigned int top_given ;	/**< @brief Whether top was given.  */
+  unsigned int output_given ;	/**< @brief Whether output was given.  */
+  unsigned int checkpoint_given ;	/**< @brief Whether checkpoint was given.  */
+  unsigned int checkpoint_seconds_given ;	/**< @brief Whether checkpoint-seconds was given.  */
+  unsigned int resume_given ;	/**< @brief Whether resume was given.  */
+  unsigned int shard_given ;	/**< @brief Whether shard was given.  */
+  unsigned int root_report_given ;	/**< @brief Whether root-report was given.  */
+  unsigned int root_report_top_given ;	/**< @brief Whether root-report-top was given.  */
 
   char **inputs ; /**< @brief unamed options (options without names) */
   unsigned inputs_num ; /**< @brief unamed options number */
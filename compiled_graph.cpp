@@ -0,0 +1,216 @@
+#include "compiled_graph.hpp"
+#include "edge_list.hpp"
+#include "graph/loading.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "macros.hpp"
+using namespace std;
+
+namespace compiled_graph {
+
+static const char MAGIC[16] = "maximal-cliques";
+static const uint32_t VERSION = 1;
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+static int64_t aligned(int64_t at) { return (at + 7) & ~int64_t(7); }
+
+bool is_compiled(const char *file_name) {
+	ifstream in(file_name, ios :: binary);
+	char magic[sizeof(MAGIC)];
+	in.read(magic, sizeof(magic));
+	return in && 0 == memcmp(magic, MAGIC, sizeof(MAGIC));
+}
+
+static void check_simple(const graph_view :: Graph *g) {
+	const int32_t N = g->numNodes();
+	for(int32_t v = 0; v < N; v++) {
+		const graph_view :: Neighbours neighs = g->neighbours(v);
+		for(size_t i = 0; i < neighs.size(); i++) {
+			const int32_t w = neighs[i];
+			const char *problem = NULL;
+			if(w < 0 || w >= N)
+				problem = "has a neighbour that isn't a node";
+			else if(w == v)
+				problem = "has a self-loop";
+			else if(i > 0 && neighs[i-1] >= w)
+				problem = "has neighbours that aren't sorted, or are repeated";
+			else if(w > v && !binary_search(g->neighbours(w).begin(), g->neighbours(w).end(), v))
+				problem = "has an edge in only one direction";
+			if(problem) {
+				ostringstream message;
+				message << "can't compile the graph: node " << v << ' ' << problem;
+				throw std :: runtime_error(message.str());
+			}
+		}
+	}
+}
+
+static void pad(ofstream &out, int64_t &at) {
+	static const char zeros[8] = {0};
+	out.write(zeros, aligned(at) - at);
+	at = aligned(at);
+}
+
+void write(const char *file_name, const graph_view :: Graph *g, const writer :: NodeNames &names) {
+	check_simple(g);
+	const int32_t N = g->numNodes();
+	unless(names.numNodes() == N)
+		throw std :: runtime_error("can't compile the graph: there isn't a name for every node");
+	vector<int64_t> offsets(N + 1, 0);
+	for(int32_t v = 0; v < N; v++)
+		offsets[v + 1] = offsets[v] + g->degree(v);
+
+	FileHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.byte_order = BYTE_ORDER_MARK;
+	header.num_nodes = N;
+	header.num_edges = offsets[N] / 2;
+	header.string_names = names.all_int64() ? 0 : 1;
+	header.offsets_at = aligned(sizeof(FileHeader));
+	header.targets_at = aligned(header.offsets_at + sizeof(int64_t) * (N + 1));
+	header.names_at = aligned(header.targets_at + sizeof(int32_t) * offsets[N]);
+	if(names.all_int64()) {
+		header.text_at = 0;
+		header.file_size = header.names_at + sizeof(int64_t) * N;
+	} else {
+		header.text_at = header.names_at + sizeof(int64_t) * (N + 1);
+		header.file_size = header.text_at + names.offset_array()[N];
+	}
+
+	ofstream out(file_name, ios :: binary | ios :: trunc);
+	unless(out)
+		throw std :: runtime_error(string("can't write to ") + file_name);
+	int64_t at = 0;
+	out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	at += sizeof(header);
+	pad(out, at);
+	out.write(reinterpret_cast<const char *>(&offsets.front()), sizeof(int64_t) * (N + 1));
+	at += sizeof(int64_t) * (N + 1);
+	pad(out, at);
+	for(int32_t v = 0; v < N; v++) {
+		const graph_view :: Neighbours neighs = g->neighbours(v);
+		unless(neighs.empty())
+			out.write(reinterpret_cast<const char *>(neighs.begin()), sizeof(int32_t) * neighs.size());
+	}
+	at += sizeof(int32_t) * offsets[N];
+	pad(out, at);
+	if(names.all_int64()) {
+		if(N > 0)
+			out.write(reinterpret_cast<const char *>(names.id_array()), sizeof(int64_t) * N);
+	} else {
+		out.write(reinterpret_cast<const char *>(names.offset_array()), sizeof(int64_t) * (N + 1));
+		if(names.offset_array()[N] > 0)
+			out.write(names.text_array(), names.offset_array()[N]);
+	}
+	out.close();
+	unless(out)
+		throw std :: runtime_error(string("failed to write ") + file_name);
+}
+
+static void check_offsets(const int64_t *offsets, int64_t n, int64_t last, const char *what, const char *file_name) { // n+1 offsets, from 0 to last, never decreasing
+	bool ok = offsets[0] == 0 && offsets[n] == last;
+	for(int64_t i = 0; ok && i < n; i++)
+		ok = offsets[i] <= offsets[i+1];
+	unless(ok)
+		throw std :: runtime_error(string("the ") + what + " in the compiled graph are damaged: " + file_name);
+}
+
+/*
+ * Each list sorted, of other nodes, with no repeats, and every edge in both lists.
+ * For that last, each (v,w) with v < w is looked for in w's list; and there must be as many of those as of (v,w) with v > w,
+ * so that w's lists have nothing more.
+ */
+static void check_targets(const int64_t *offsets, const int32_t *targets, int64_t N, const char *file_name) {
+	int64_t up = 0, down = 0;
+	for(int64_t v = 0; v < N; v++)
+		for(int64_t i = offsets[v]; i < offsets[v+1]; i++) {
+			const int32_t w = targets[i];
+			unless(w >= 0 && w < N && w != v && (i == offsets[v] || targets[i-1] < w)
+					&& (w < v || binary_search(targets + offsets[w], targets + offsets[w+1], int32_t(v))))
+				throw std :: runtime_error(string("the neighbour lists in the compiled graph are damaged: ") + file_name);
+			++ (w < v ? down : up);
+		}
+	unless(up == down)
+		throw std :: runtime_error(string("the neighbour lists in the compiled graph are damaged: ") + file_name);
+}
+
+MappedGraph :: MappedGraph(const char *file_name) : base(NULL), length(0) {
+	const int fd = open(file_name, O_RDONLY);
+	struct stat st;
+	unless(fd >= 0 && 0 == fstat(fd, &st)) {
+		const string problem = strerror(errno);
+		if(fd >= 0)
+			::close(fd);
+		throw std :: runtime_error(string("can't read ") + file_name + ": " + problem);
+	}
+	this->length = size_t(st.st_size);
+	unless(this->length >= sizeof(FileHeader)) {
+		::close(fd);
+		throw std :: runtime_error(string("not a compiled graph: ") + file_name);
+	}
+	this->base = mmap(NULL, this->length, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if(this->base == MAP_FAILED)
+		throw std :: runtime_error(string("can't map ") + file_name + ": " + strerror(errno));
+
+	try {
+		const char *bytes = static_cast<const char *>(this->base);
+		FileHeader h;
+		memcpy(&h, bytes, sizeof(FileHeader));
+		unless(0 == memcmp(h.magic, MAGIC, sizeof(MAGIC)))
+			throw std :: runtime_error(string("not a compiled graph: ") + file_name);
+		unless(h.version == VERSION && h.byte_order == BYTE_ORDER_MARK)
+			throw std :: runtime_error(string("compiled by a different version, or on a different kind of machine; compile it again: ") + file_name);
+		const int64_t N = h.num_nodes;
+		const int64_t names_end = h.string_names ? h.text_at : h.names_at + int64_t(sizeof(int64_t)) * N;
+		unless(0 <= N && N < (int64_t(1) << 31) && 0 <= h.num_edges && h.file_size == int64_t(this->length)
+				&& h.offsets_at == aligned(sizeof(FileHeader))
+				&& h.targets_at == aligned(h.offsets_at + sizeof(int64_t) * (N + 1))
+				&& h.names_at == aligned(h.targets_at + sizeof(int32_t) * 2 * h.num_edges)
+				&& names_end <= h.file_size
+				&& (h.string_names == 0 || h.text_at == h.names_at + int64_t(sizeof(int64_t)) * (N + 1)))
+			throw std :: runtime_error(string("the compiled graph is damaged: ") + file_name);
+
+		const int64_t *offsets = reinterpret_cast<const int64_t *>(bytes + h.offsets_at);
+		const int32_t *targets = reinterpret_cast<const int32_t *>(bytes + h.targets_at);
+		check_offsets(offsets, N, 2 * h.num_edges, "neighbour lists", file_name);
+		check_targets(offsets, targets, N, file_name);
+		this->csr.attach(int32_t(N), offsets, targets);
+		if(h.string_names) {
+			const int64_t *name_offsets = reinterpret_cast<const int64_t *>(bytes + h.names_at);
+			check_offsets(name_offsets, N, h.file_size - h.text_at, "names", file_name);
+			this->the_names = new writer :: NodeNames(int32_t(N), name_offsets, bytes + h.text_at);
+		} else
+			this->the_names = new writer :: NodeNames(int32_t(N), reinterpret_cast<const int64_t *>(bytes + h.names_at));
+	} catch (std :: runtime_error &) {
+		munmap(this->base, this->length);
+		throw;
+	}
+}
+
+MappedGraph :: ~MappedGraph() {
+	munmap(this->base, this->length);
+}
+
+void load(const char *file_name, bool string_ids, int parse_threads, Loaded &loaded) {
+	if(is_compiled(file_name))
+		loaded.csr = new MappedGraph(file_name);
+	else if(parse_threads > 0)
+		loaded.csr = new edge_list :: ParsedGraph(file_name, parse_threads, string_ids);
+	else if(string_ids)
+		loaded.network = graph :: loading :: make_Network_from_edge_list_string(file_name, false, false, true).release();
+	else
+		loaded.network = graph :: loading :: make_Network_from_edge_list_int64(file_name, false, false, true, 0).release();
+}
+
+} // namespace compiled_graph
@@ -0,0 +1,112 @@
+#ifndef _COMPILED_GRAPH_HPP_
+#define _COMPILED_GRAPH_HPP_
+
+#include "graph/network.hpp"
+#include "graph_view.hpp"
+#include "writer.hpp"
+#include <string>
+
+/*
+ * A graph file that the binaries map into memory and search as it is, with no parsing: graph-compile
+ * makes one from an edge list. The file is, in this machine's byte order, with each part 8-byte aligned:
+ *   FileHeader
+ *   int64_t offsets[num_nodes+1]  \  the graph, as a graph_view :: CsrGraph. Each list is sorted, with
+ *   int32_t targets[2*num_edges]  /  no duplicates and no self-loops, and every edge is in both lists
+ *   the names, as writer :: NodeNames keeps them: int64_t ids[num_nodes] if every name is a plain integer,
+ *   or else int64_t name_offsets[num_nodes+1] and then the chars of the names, back-to-back
+ * A file from a different version, or from a machine with the other byte order, is refused.
+ */
+
+namespace compiled_graph {
+
+struct FileHeader {
+	char magic[16];
+	uint32_t version;
+	uint32_t byte_order; // BYTE_ORDER_MARK, as this machine stores it
+	int64_t num_nodes;
+	int64_t num_edges;
+	int64_t string_names; // 0 if the names are int64 ids, 1 if they're text
+	int64_t offsets_at; // where each part starts, in bytes from the start of the file
+	int64_t targets_at;
+	int64_t names_at;
+	int64_t text_at; // only for text names
+	int64_t file_size;
+};
+
+bool is_compiled(const char *file_name); // does it start like a compiled graph? (Any version.) False if it can't be read
+
+/*
+ * Write g, and its names, to file_name.
+ * Throws std :: runtime_error if g isn't a simple undirected graph with sorted lists, or if the file can't be written.
+ */
+void write(const char *file_name, const graph_view :: Graph *g, const writer :: NodeNames &names);
+
+/*
+ * A graph as a graph_view :: CsrGraph, with its names: a MappedGraph, or an edge list parsed straight into CSR (see edge_list.hpp).
+ */
+class CsrNetwork {
+public:
+	const graph_view :: CsrGraph & graph() const { return this->csr; }
+	const writer :: NodeNames & names() const { return *this->the_names; }
+	int64_t num_edges() const { return this->csr.num_targets() / 2; }
+	virtual ~CsrNetwork() { delete this->the_names; }
+protected:
+	CsrNetwork() : the_names(NULL) {}
+	graph_view :: CsrGraph csr;
+	const writer :: NodeNames *the_names; // set by the derived class, and deleted here
+private:
+	CsrNetwork(const CsrNetwork &);
+	CsrNetwork & operator= (const CsrNetwork &);
+};
+
+class MappedGraph : public CsrNetwork {
+public:
+	explicit MappedGraph(const char *file_name); // throws std :: runtime_error if it can't be mapped, isn't a compiled graph of this version, or is damaged
+	virtual ~MappedGraph();
+private:
+	void *base;
+	size_t length;
+};
+
+/*
+ * What the search reads: a network loaded from an edge list by lib_graph, or a CsrNetwork.
+ * Both convert to an Input, so the cliques :: functions take either.
+ */
+class Input {
+public:
+	Input(const graph :: NetworkInterfaceConvertedToString *_net) : net(_net), csr(NULL), view(_net->get_plain_graph()) {}
+	Input(const CsrNetwork *_csr) : net(NULL), csr(_csr), view(NULL) {}
+	const graph_view :: Graph * graph() const { return this->csr ? static_cast<const graph_view :: Graph *>(&this->csr->graph()) : &this->view; }
+	int32_t numNodes() const { return this->graph()->numNodes(); }
+	int64_t numRels() const { return this->csr ? this->csr->num_edges() : this->net->numRels(); }
+	std :: string node_name(int32_t node_id) const { return this->csr ? this->csr->names().name(node_id) : this->net->node_name_as_string(node_id); }
+	const graph :: NetworkInterfaceConvertedToString * const net; // exactly one of these isn't NULL
+	const CsrNetwork * const csr;
+private:
+	graph_view :: NetworkView view;
+};
+
+class Loaded { // what load() found, which it owns
+public:
+	Loaded() : network(NULL), csr(NULL) {}
+	~Loaded() { delete this->network; delete this->csr; }
+	Input input() const { return this->csr ? Input(this->csr) : Input(this->network); }
+	graph :: NetworkInterfaceConvertedToString *network; // exactly one of these is set, by load()
+	CsrNetwork *csr;
+private:
+	Loaded(const Loaded &);
+	Loaded & operator= (const Loaded &);
+};
+
+/*
+ * The network in file_name: mapped, if it's a compiled graph; otherwise read from the edge list, with string_ids as --stringIDs asks.
+ * That's by lib_graph, unless parse_threads > 0; then edge_list parses it with that many threads.
+ * (A compiled graph knows what its names are, so string_ids doesn't matter for it.)
+ * 'loaded' should be empty.
+ * Throws std :: runtime_error if a compiled graph can't be mapped, or if edge_list can't parse the file.
+ */
+void load(const char *file_name, bool string_ids, int parse_threads, Loaded &loaded);
+
+} // namespace compiled_graph
+
+#endif
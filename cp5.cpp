@@ -1,6 +1,4 @@
 #include "graph/network.hpp"
-#include "graph/loading.hpp"
-#include "graph/stats.hpp"
 #include "macros.hpp"
 #include "cliques.hpp"
 #include "cmdline-cp5.h"
@@ -105,13 +103,13 @@ public:
 };
 
 
-static void do_clique_percolation_variant_5b(const int32_t min_k, const int32_t max_k, const int32_t max_k_to_percolate, const vector< clique > &the_cliques, const char * output_dir_name, const graph :: NetworkInterfaceConvertedToString *network) ;
+static void do_clique_percolation_variant_5b(const int32_t min_k, const int32_t max_k, const int32_t max_k_to_percolate, const vector< clique > &the_cliques, const char * output_dir_name, const compiled_graph :: Input &network) ;
 static void write_all_communities_for_this_k(const char * output_dir_name
 		, const int32_t k
 		, const vector<int32_t> &found_communities
 		, const comp & current_percolation_level
 		, const vector<clique> &the_cliques
-		, const graph :: NetworkInterfaceConvertedToString *network
+		, const compiled_graph :: Input &network
 		);
 static void create_directory_for_output(const char *dir);
 static void source_components_for_the_next_level (
@@ -147,7 +145,7 @@ int main(int argc, char **argv) {
 	if (cmdline_parser (argc, argv, &args_info) != 0)
 		exit(1) ;
 	// .. and there should be exactly one non-option arg
-	if(args_info.inputs_num != 2 || args_info.k_arg < 3) {
+	if(args_info.inputs_num != 2 || args_info.k_arg < 3 || args_info.threads_arg < 1) {
 		cmdline_parser_print_help();
 		exit(1);
 	}
@@ -165,29 +163,41 @@ int main(int argc, char **argv) {
 	assert(min_k > 2);
 	assert(max_k_to_percolate >= min_k);
 
-        std :: auto_ptr<graph :: NetworkInterfaceConvertedToString > network;
-	if(args_info.stringIDs_flag) {
-		network	= graph :: loading :: make_Network_from_edge_list_string(edgeListFileName, false, false, true);
-	} else {
-		network	= graph :: loading :: make_Network_from_edge_list_int64(edgeListFileName, false, false, true, 0);
+	compiled_graph :: Loaded loaded; // the network, or a compiled graph (see graph-compile), or one parsed with --parallel-load
+	try {
+		compiled_graph :: load(edgeListFileName, args_info.stringIDs_flag, args_info.parallel_load_flag ? args_info.threads_arg : 0, loaded);
+	} catch (std :: exception &e) {
+		cerr << "Error: " << e.what() << endl;
+		exit(1);
 	}
+	const compiled_graph :: Input input = loaded.input();
 
-	int32_t maxDegree = graph :: stats :: get_max_degree(network->get_plain_graph());
+	int32_t maxDegree = graph_view :: max_degree(input.graph());
 
 	double elapsed_seconds = double(clock()) / CLOCKS_PER_SEC;
 	cerr << "Network loaded"
 	       << " after " << elapsed_seconds << " seconds. "
-		<< network.get()->numNodes() << " nodes and " << network.get()->numRels() << " edges."
+		<< input.numNodes() << " nodes and " << input.numRels() << " edges."
 		<< " Max degree is " << maxDegree
 	       << endl;
 	cout << "Network loaded"
 	       << " after " << elapsed_seconds << " seconds. "
-		<< network.get()->numNodes() << " nodes and " << network.get()->numRels() << " edges."
+		<< input.numNodes() << " nodes and " << input.numRels() << " edges."
 		<< " Max degree is " << maxDegree
 	       << endl;
 
 	vector< clique > the_cliques;
-	cliques :: cliquesToVector(network.get(), min_k, the_cliques);
+	cliques :: SearchOptions options;
+	options.num_threads = args_info.threads_arg;
+	options.degeneracy_order = args_info.degeneracy_flag;
+	options.truss = args_info.truss_flag;
+	options.csr = args_info.csr_flag;
+	options.adjacency_index = args_info.adjacency_index_flag;
+	unless(relabel :: parse(args_info.relabel_arg, options.relabel)) {
+		cerr << "Error: --relabel should be none, degree, rcm or bfs, not " << args_info.relabel_arg << endl;
+		exit(1);
+	}
+	cliques :: cliquesToVector(input, min_k, the_cliques, options);
 
 	// sort 'em here? By size? lexicographically? Graclus?
 
@@ -213,7 +223,7 @@ int main(int argc, char **argv) {
 
 	// finally, call the clique_percolation algorithm proper
 
-	do_clique_percolation_variant_5b(min_k, max_clique_size, max_k_to_percolate, the_cliques, output_dir_name, network.get());
+	do_clique_percolation_variant_5b(min_k, max_clique_size, max_k_to_percolate, the_cliques, output_dir_name, input);
 }
 
 const static size_t BLOOM_BITS = 4000000000UL;  /// 0.50 GB    // for 32-bit
@@ -549,10 +559,9 @@ static void one_k (vector<int32_t> & found_communities
 		, const int32_t C
 	     );
 
-static void do_clique_percolation_variant_5b(const int32_t min_k, const int32_t max_k, const int32_t max_k_to_percolate, const vector< clique > &the_cliques, const char * output_dir_name, const graph :: NetworkInterfaceConvertedToString *network) {
+static void do_clique_percolation_variant_5b(const int32_t min_k, const int32_t max_k, const int32_t max_k_to_percolate, const vector< clique > &the_cliques, const char * output_dir_name, const compiled_graph :: Input &network) {
 	assert(max_k_to_percolate <= max_k);
 
-	assert(network);
 	assert(output_dir_name);
 	if(the_cliques.size() > static_cast<size_t>(std :: numeric_limits<int32_t> :: max())) {
 		throw too_many_cliques_exception();
@@ -856,7 +865,7 @@ static void write_all_communities_for_this_k(const char * output_dir_name
 		, const vector<int32_t> &found_communities
 		, const comp & current_percolation_level
 		, const vector<clique> &the_cliques
-		, const graph :: NetworkInterfaceConvertedToString *network
+		, const compiled_graph :: Input &network
 		) {
 			const int32_t C = the_cliques.size();
 			map<int32_t, tr1 :: unordered_set<int32_t> > node_ids_in_each_community;
@@ -907,7 +916,7 @@ static void write_all_communities_for_this_k(const char * output_dir_name
 						; it != node_ids_in_this_community_sorted.end()
 						; ++it ) {
 					const int32_t node_id = *it;
-					const std :: string node_name = network->node_name_as_string(node_id);
+					const std :: string node_name = network.node_name(node_id);
 					if(!first_node_on_this_line)
 						write_nodes_here << ' ';
 					write_nodes_here << node_name;
@@ -927,7 +936,7 @@ static void write_all_communities_for_this_k(const char * output_dir_name
 					For(one_clique_id, comm_of_cliques->second) {
 						const clique & the_clique_sorted = the_cliques.at(*one_clique_id);
 						For(node_id, the_clique_sorted) {
-							write_cliques_here << ' ' << network->node_name_as_string(*node_id);
+							write_cliques_here << ' ' << network.node_name(*node_id);
 						}
 						write_cliques_here << endl;
 					}
@@ -0,0 +1,402 @@
+#include "edge_list.hpp"
+#include "parallel.hpp"
+#include "string_ids.hpp"
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "macros.hpp"
+using namespace std;
+
+namespace edge_list {
+
+struct MappedFile { // the whole file, read-only
+	const char *begin;
+	size_t length;
+	explicit MappedFile(const char *file_name) : begin(NULL), length(0) {
+		const int fd = open(file_name, O_RDONLY);
+		struct stat st;
+		unless(fd >= 0 && 0 == fstat(fd, &st)) {
+			const string problem = strerror(errno);
+			if(fd >= 0)
+				::close(fd);
+			throw std :: runtime_error(string("can't read ") + file_name + ": " + problem);
+		}
+		this->length = size_t(st.st_size);
+		if(this->length > 0) {
+			void *p = mmap(NULL, this->length, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(p == MAP_FAILED) {
+				const string problem = strerror(errno);
+				::close(fd);
+				throw std :: runtime_error(string("can't map ") + file_name + ": " + problem);
+			}
+			madvise(p, this->length, MADV_SEQUENTIAL);
+			this->begin = static_cast<const char *>(p);
+		}
+		::close(fd);
+	}
+	~MappedFile() {
+		if(this->begin)
+			munmap(const_cast<char *>(this->begin), this->length);
+	}
+private:
+	MappedFile(const MappedFile &);
+	MappedFile & operator= (const MappedFile &);
+};
+
+static inline bool is_delimiter(char c) { return c == ' ' || c == '\t' || c == ',' || c == '|'; }
+
+static const uint64_t INT64_LIMIT = uint64_t(numeric_limits<int64_t> :: max());
+
+static inline bool scan_int64(const char *&p, const char *end, int64_t &x) { // a decimal integer, maybe with a '-'. False if there's none, or it's too big
+	const bool negative = p < end && *p == '-';
+	if(negative)
+		++p;
+	const char *digits = p;
+	uint64_t magnitude = 0;
+	while(p < end && unsigned(*p - '0') < 10u) {
+		const unsigned d = unsigned(*p - '0');
+		if(magnitude > (INT64_LIMIT + 1 - d) / 10)
+			return false;
+		magnitude = magnitude * 10 + d;
+		++p;
+	}
+	if(p == digits || (!negative && magnitude > INT64_LIMIT))
+		return false;
+	x = negative ? int64_t(0 - magnitude) : int64_t(magnitude);
+	return true;
+}
+
+static inline const char * field_end(const char *p, const char *end) {
+	while(p < end && !is_delimiter(*p) && *p != '\r' && *p != '\n')
+		++p;
+	return p;
+}
+
+static inline bool scan_field(const char *b, const char *e, int64_t &x) { // the whole field must be the integer
+	return scan_int64(b, e, x) && b == e;
+}
+
+struct ChunkOfStrings { // with --stringIDs, what one chunk has been parsed into
+	string_ids :: Interner names;
+	vector<int32_t> arcs; // two per edge, in the ids of 'names'
+};
+
+/*
+ * Chunk c is the lines in [starts[c],starts[c+1]). With integer IDs, it's parsed into names[c], two per edge;
+ * with string IDs, into strings[c].
+ */
+struct ParseChunks : public parallel :: IndexedTask {
+	const MappedFile &file;
+	const vector<size_t> &starts;
+	vector< vector<int64_t> > &names;
+	vector<ChunkOfStrings *> &strings;
+	vector<string> &errors;
+	ParseChunks(const MappedFile &_file, const vector<size_t> &_starts, vector< vector<int64_t> > &_names, vector<ChunkOfStrings *> &_strings, vector<string> &_errors)
+		: file(_file), starts(_starts), names(_names), strings(_strings), errors(_errors) {}
+	virtual void run(int64_t c, int) {
+		const char *p = this->file.begin + this->starts[c];
+		const char * const end = this->file.begin + this->starts[c+1];
+		while(p < end) {
+			const char * const line = p;
+			while(p < end && is_delimiter(*p))
+				++p;
+			if(p < end && *p != '\n' && *p != '\r' && *p != '#') {
+				const char * const b1 = p;
+				const char * const e1 = p = field_end(p, end);
+				const bool delimited = p < end && is_delimiter(*p);
+				while(p < end && is_delimiter(*p))
+					++p;
+				const char * const b2 = p;
+				const char * const e2 = p = field_end(p, end);
+				const bool two_fields = delimited && b2 != e2;
+				const char *problem = NULL;
+				if(this->strings.empty()) {
+					int64_t a = 0, b = 0;
+					unless(two_fields && scan_field(b1, e1, a) && scan_field(b2, e2, b))
+						problem = "can't read two integer IDs from the line";
+					else if(a == b)
+						problem = "self-loops aren't allowed, but there's one on the line";
+					else {
+						this->names[c].push_back(a);
+						this->names[c].push_back(b);
+					}
+				} else {
+					unless(two_fields)
+						problem = "can't read two IDs from the line";
+					else {
+						ChunkOfStrings &out = *this->strings[c];
+						const int32_t a = out.names.intern(b1, e1);
+						const int32_t b = out.names.intern(b2, e2);
+						if(a == b)
+							problem = "self-loops aren't allowed, but there's one on the line";
+						out.arcs.push_back(a);
+						out.arcs.push_back(b);
+					}
+				}
+				if(problem) {
+					ostringstream message;
+					message << problem << " at byte " << (line - this->file.begin);
+					this->errors[c] = message.str();
+					return;
+				}
+			}
+			const char * const newline = static_cast<const char *>(memchr(p, '\n', end - p));
+			p = newline ? newline + 1 : end;
+		}
+	}
+};
+
+struct NamesToIds : public parallel :: IndexedTask { // the names in chunk c, as node ids, from arcs[offsets[c]] on
+	const vector<int64_t> &sorted_names;
+	const vector< vector<int64_t> > &names;
+	const vector<size_t> &offsets;
+	vector<int32_t> &arcs;
+	NamesToIds(const vector<int64_t> &_sorted_names, const vector< vector<int64_t> > &_names, const vector<size_t> &_offsets, vector<int32_t> &_arcs)
+		: sorted_names(_sorted_names), names(_names), offsets(_offsets), arcs(_arcs) {}
+	virtual void run(int64_t c, int) {
+		const vector<int64_t> &in = this->names[c];
+		for(size_t i = 0; i < in.size(); i++)
+			this->arcs[this->offsets[c] + i] = int32_t(lower_bound(this->sorted_names.begin(), this->sorted_names.end(), in[i]) - this->sorted_names.begin());
+	}
+};
+
+struct LocalToGlobal : public parallel :: IndexedTask { // the arcs of chunk c, in the ids of all the names, from arcs[offsets[c]] on
+	const vector<ChunkOfStrings *> &strings;
+	const vector< vector<int32_t> > &global_of_local;
+	const vector<size_t> &offsets;
+	vector<int32_t> &arcs;
+	LocalToGlobal(const vector<ChunkOfStrings *> &_strings, const vector< vector<int32_t> > &_global_of_local, const vector<size_t> &_offsets, vector<int32_t> &_arcs)
+		: strings(_strings), global_of_local(_global_of_local), offsets(_offsets), arcs(_arcs) {}
+	virtual void run(int64_t c, int) {
+		const vector<int32_t> &in = this->strings[c]->arcs;
+		for(size_t i = 0; i < in.size(); i++)
+			this->arcs[this->offsets[c] + i] = this->global_of_local[c][in[i]];
+	}
+};
+
+/*
+ * LSD radix sort of keys below 2^key_bits, RADIX_BITS at a time. In each pass, every thread counts the digits in its own
+ * block of the keys; from all the counts, each block learns where its keys with each digit go, and scatters them there.
+ * That keeps each pass stable. A pass where every key has the same digit is skipped, so small ids cost fewer passes.
+ */
+static const int RADIX_BITS = 11;
+
+struct RadixPass : public parallel :: IndexedTask {
+	const vector<uint64_t> &in;
+	vector<uint64_t> &out;
+	const int shift;
+	vector< vector<size_t> > &counts; // per block, per digit: how many, or (when scattering) where the next one goes
+	const bool scatter;
+	RadixPass(const vector<uint64_t> &_in, vector<uint64_t> &_out, int _shift, vector< vector<size_t> > &_counts, bool _scatter)
+		: in(_in), out(_out), shift(_shift), counts(_counts), scatter(_scatter) {}
+	virtual void run(int64_t b, int) {
+		const size_t blocks = this->counts.size();
+		const size_t begin = this->in.size() / blocks * b;
+		const size_t end = size_t(b) + 1 == blocks ? this->in.size() : this->in.size() / blocks * (b + 1);
+		const uint64_t mask = (uint64_t(1) << RADIX_BITS) - 1;
+		vector<size_t> &c = this->counts[b];
+		if(this->scatter)
+			for(size_t i = begin; i < end; i++)
+				this->out[c[(this->in[i] >> this->shift) & mask]++] = this->in[i];
+		else
+			for(size_t i = begin; i < end; i++)
+				++ c[(this->in[i] >> this->shift) & mask];
+	}
+};
+
+static void radix_sort(vector<uint64_t> &keys, int key_bits, int num_threads) {
+	const size_t blocks = num_threads > 1 ? size_t(num_threads) : 1;
+	vector<uint64_t> other(keys.size());
+	vector< vector<size_t> > counts(blocks);
+	for(int shift = 0; shift < key_bits; shift += RADIX_BITS) {
+		For(c, counts)
+			c->assign(size_t(1) << RADIX_BITS, 0);
+		RadixPass count(keys, other, shift, counts, false);
+		parallel :: for_each_index(int64_t(blocks), num_threads, count);
+		size_t at = 0;
+		bool one_digit = false;
+		for(size_t d = 0; d < (size_t(1) << RADIX_BITS); d++) {
+			size_t with_d = 0;
+			for(size_t b = 0; b < blocks; b++) {
+				const size_t n = counts[b][d];
+				counts[b][d] = at;
+				at += n;
+				with_d += n;
+			}
+			if(with_d == keys.size())
+				one_digit = true;
+		}
+		if(one_digit)
+			continue;
+		RadixPass scatter(keys, other, shift, counts, true);
+		parallel :: for_each_index(int64_t(blocks), num_threads, scatter);
+		keys.swap(other);
+	}
+}
+
+struct OwnedChunks { // deletes them, even if parsing throws
+	vector<ChunkOfStrings *> chunks;
+	~OwnedChunks() {
+		For(c, this->chunks)
+			delete *c;
+	}
+};
+
+/*
+ * With integer IDs, node_names are the names in increasing order. With string IDs, the names are in text and
+ * text_offsets, in the order they first appear in the file, whatever the number of threads.
+ */
+static void parse(const char *file_name, int num_threads, bool string_ids
+		, vector<int64_t> &node_names, vector<char> &text, vector<int64_t> &text_offsets, vector<int32_t> &arcs) {
+	const MappedFile file(file_name);
+
+	// the chunks. Each starts just after a '\n' (or at the start of the file)
+	const size_t target_chunks = num_threads > 1 ? 16 * size_t(num_threads) : 1;
+	const size_t num_chunks = min(target_chunks, file.length / 65536 + 1);
+	vector<size_t> starts(num_chunks + 1, file.length);
+	starts[0] = 0;
+	for(size_t c = 1; c < num_chunks; c++) {
+		size_t at = max(starts[c-1], file.length / num_chunks * c);
+		while(at > 0 && at < file.length && file.begin[at-1] != '\n')
+			++ at;
+		starts[c] = at;
+	}
+
+	vector< vector<int64_t> > names(string_ids ? 0 : num_chunks);
+	OwnedChunks strings;
+	if(string_ids)
+		for(size_t c = 0; c < num_chunks; c++)
+			strings.chunks.push_back(new ChunkOfStrings);
+	{
+		vector<string> errors(num_chunks);
+		ParseChunks parse_chunks(file, starts, names, strings.chunks, errors);
+		parallel :: for_each_index(int64_t(num_chunks), num_threads, parse_chunks);
+		For(e, errors)
+			unless(e->empty())
+				throw std :: runtime_error(string(file_name) + ": " + *e);
+	}
+
+	vector<size_t> offsets(num_chunks + 1, 0);
+	for(size_t c = 0; c < num_chunks; c++)
+		offsets[c+1] = offsets[c] + (string_ids ? strings.chunks[c]->arcs.size() : names[c].size());
+	arcs.resize(offsets[num_chunks]);
+
+	if(string_ids) {
+		// chunk by chunk, in order, so the ids are in order of first appearance
+		string_ids :: Interner all;
+		vector< vector<int32_t> > global_of_local(num_chunks);
+		for(size_t c = 0; c < num_chunks; c++) {
+			string_ids :: Interner &local = strings.chunks[c]->names;
+			global_of_local[c].resize(local.size());
+			for(int32_t id = 0; id < local.size(); id++)
+				global_of_local[c][id] = all.intern(local.name_begin(id), local.name_end(id));
+			vector<char> unused_text;
+			vector<int64_t> unused_offsets;
+			local.release(unused_text, unused_offsets);
+		}
+		unless(all.size() < numeric_limits<int32_t> :: max())
+			throw std :: runtime_error(string(file_name) + ": too many nodes");
+		LocalToGlobal to_ids(strings.chunks, global_of_local, offsets, arcs);
+		parallel :: for_each_index(int64_t(num_chunks), num_threads, to_ids);
+		all.release(text, text_offsets);
+		vector<char>(text).swap(text);
+		return;
+	}
+
+	{
+		const uint64_t sign = uint64_t(1) << 63; // flipping it puts the negative names first, as unsigned keys
+		vector<uint64_t> keys;
+		keys.reserve(offsets[num_chunks]);
+		For(chunk, names)
+			For(name, *chunk)
+				keys.push_back(uint64_t(*name) ^ sign);
+		radix_sort(keys, 64, num_threads);
+		keys.erase(unique(keys.begin(), keys.end()), keys.end());
+		node_names.resize(keys.size());
+		for(size_t i = 0; i < keys.size(); i++)
+			node_names[i] = int64_t(keys[i] ^ sign);
+	}
+	unless(node_names.size() < size_t(1) << 31)
+		throw std :: runtime_error(string(file_name) + ": too many nodes");
+	NamesToIds to_ids(node_names, names, offsets, arcs);
+	parallel :: for_each_index(int64_t(num_chunks), num_threads, to_ids);
+}
+
+struct MakeKeys : public parallel :: IndexedTask { // both directions of edge i, as keys[2i] and keys[2i+1]
+	const vector<int32_t> &arcs;
+	vector<uint64_t> &keys;
+	const int id_bits;
+	const int64_t edges_per_block;
+	int32_t self_loop; // a node with one, or -1. Any thread may set it
+	MakeKeys(const vector<int32_t> &_arcs, vector<uint64_t> &_keys, int _id_bits, int64_t _edges_per_block)
+		: arcs(_arcs), keys(_keys), id_bits(_id_bits), edges_per_block(_edges_per_block), self_loop(-1) {}
+	virtual void run(int64_t b, int) {
+		const int64_t edges = int64_t(this->arcs.size() / 2);
+		const int64_t end = min(edges, (b + 1) * this->edges_per_block);
+		for(int64_t i = b * this->edges_per_block; i < end; i++) {
+			const uint64_t u = uint32_t(this->arcs[2*i]), v = uint32_t(this->arcs[2*i+1]);
+			if(u == v)
+				this->self_loop = int32_t(u);
+			this->keys[2*i]   = (u << this->id_bits) | v;
+			this->keys[2*i+1] = (v << this->id_bits) | u;
+		}
+	}
+};
+
+void build_csr(int32_t num_nodes, vector<int32_t> &arcs, graph_view :: CsrGraph &csr, int num_threads) {
+	int id_bits = 1;
+	while((int64_t(1) << id_bits) < num_nodes)
+		++ id_bits;
+	const uint64_t id_mask = (uint64_t(1) << id_bits) - 1;
+
+	vector<uint64_t> keys(arcs.size()); // both directions of every edge, as (from << id_bits) | to
+	{
+		const int64_t edges = int64_t(arcs.size() / 2);
+		const int64_t blocks = num_threads > 1 ? 4 * int64_t(num_threads) : 1;
+		MakeKeys make_keys(arcs, keys, id_bits, edges / blocks + 1);
+		parallel :: for_each_index(blocks, num_threads, make_keys);
+		if(make_keys.self_loop >= 0) {
+			ostringstream problem;
+			problem << "self-loops aren't allowed, but node " << make_keys.self_loop << " has one";
+			throw std :: runtime_error(problem.str());
+		}
+	}
+	vector<int32_t>().swap(arcs);
+	radix_sort(keys, 2 * id_bits, num_threads);
+
+	// sorted by 'from', then 'to', so each list comes out sorted. A key equal to the one before is a duplicate
+	vector<int64_t> offsets(num_nodes + 1, 0);
+	vector<int32_t> targets;
+	targets.reserve(keys.size());
+	for(size_t i = 0; i < keys.size(); i++) {
+		if(i > 0 && keys[i] == keys[i-1])
+			continue;
+		++ offsets[(keys[i] >> id_bits) + 1];
+		targets.push_back(int32_t(keys[i] & id_mask));
+	}
+	vector<uint64_t>().swap(keys);
+	for(int32_t v = 0; v < num_nodes; v++)
+		offsets[v+1] += offsets[v];
+	vector<int32_t>(targets).swap(targets);
+	csr.assign(offsets, targets);
+}
+
+ParsedGraph :: ParsedGraph(const char *file_name, int num_threads, bool string_ids) {
+	vector<int32_t> arcs;
+	parse(file_name, num_threads, string_ids, this->node_names, this->text, this->text_offsets, arcs);
+	const int32_t N = int32_t(string_ids ? this->text_offsets.size() - 1 : this->node_names.size());
+	build_csr(N, arcs, this->csr, num_threads);
+	if(string_ids)
+		this->the_names = new writer :: NodeNames(N, &this->text_offsets.front(), this->text.empty() ? NULL : &this->text.front());
+	else
+		this->the_names = new writer :: NodeNames(N, this->node_names.empty() ? NULL : &this->node_names.front());
+}
+
+} // namespace edge_list
@@ -0,0 +1,40 @@
+#ifndef _EDGE_LIST_HPP_
+#define _EDGE_LIST_HPP_
+
+#include "compiled_graph.hpp"
+#include <vector>
+
+/*
+ * A parallel loader for edge lists, for when parsing a big file one line at a time takes longer than the search.
+ * The file is mapped into memory and cut into chunks that start and end on line boundaries, and the threads each
+ * parse chunks into their own buffer of edges: integer IDs with a hand-written scanner, or string IDs into the
+ * chunk's own string_ids :: Interner, whose names are then interned again, chunk by chunk, into one for the whole file.
+ * The input is as the lib_graph loader reads it: the first two fields of each line, split by commas, pipes,
+ * spaces or tabs, are the names; anything after them is ignored. Blank lines, and lines starting with '#', are skipped.
+ * Integer names get node ids in increasing order; string names in order of first appearance.
+ * Duplicate edges are dropped, and self-loops are rejected.
+ */
+
+namespace edge_list {
+
+class ParsedGraph : public compiled_graph :: CsrNetwork {
+public:
+	ParsedGraph(const char *file_name, int num_threads, bool string_ids); // throws std :: runtime_error if the file can't be read, or a line can't be parsed
+private:
+	std :: vector<int64_t> node_names; // with integer IDs
+	std :: vector<char> text; // with string IDs, the names are back-to-back (see writer :: NodeNames)
+	std :: vector<int64_t> text_offsets;
+};
+
+/*
+ * The CSR of a graph with num_nodes nodes, from its edges as pairs of node ids, (a,b) in arcs[2*i], arcs[2*i+1].
+ * Each edge may be in either or both directions, and more than once. arcs is used up.
+ * Both directions of every edge are packed into 64-bit keys, (from,to), and sorted by a parallel LSD radix sort;
+ * then one pass over the keys drops the duplicates and gives the sorted lists. No list is sorted on its own.
+ * Throws std :: runtime_error if there's a self-loop.
+ */
+void build_csr(int32_t num_nodes, std :: vector<int32_t> &arcs, graph_view :: CsrGraph &csr, int num_threads);
+
+} // namespace edge_list
+
+#endif
@@ -0,0 +1,54 @@
+using namespace std;
+#include "graph/network.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <stdexcept>
+
+#include "macros.hpp"
+#include "compiled_graph.hpp"
+#include "cmdline-graph-compile.h"
+
+/*
+ * Loads an edge list, as justTheCliques would, and writes it as a compiled graph (see compiled_graph.hpp).
+ * The loader has dropped the duplicate edges already, and rejected self-loops; the graph is checked again before it's written.
+ * (If the input is a compiled graph already, it's just written again.)
+ */
+
+int main(int argc, char **argv) {
+	gengetopt_args_info args_info;
+
+	// there shouldn't be any errors in processing args
+	if (cmdline_parser (argc, argv, &args_info) != 0)
+		exit(1) ;
+	// .. and there should be exactly two non-option args
+	if(args_info.inputs_num != 2 || args_info.threads_arg < 1) {
+		cmdline_parser_print_help();
+		exit(1);
+	}
+	const char * edgeListFileName   = args_info.inputs[0];
+	const char * outputFileName     = args_info.inputs[1];
+
+	try {
+		compiled_graph :: Loaded loaded; // the network, or with --parallel-load a CsrNetwork
+		compiled_graph :: load(edgeListFileName, args_info.stringIDs_flag, args_info.parallel_load_flag ? args_info.threads_arg : 0, loaded);
+		const compiled_graph :: Input input = loaded.input();
+		cerr << "Network loaded"
+		       << " after " << (double(clock()) / CLOCKS_PER_SEC) << " seconds. "
+			<< input.numNodes() << " nodes and " << input.numRels() << " edges."
+		       << endl;
+
+		if(loaded.network) {
+			const writer :: NodeNames names(loaded.network);
+			compiled_graph :: write(outputFileName, input.graph(), names);
+		} else // a CsrNetwork has its names already
+			compiled_graph :: write(outputFileName, input.graph(), loaded.csr->names());
+		const compiled_graph :: MappedGraph check(outputFileName);
+		unless(check.graph().numNodes() == input.numNodes() && check.num_edges() == input.numRels())
+			throw std :: runtime_error(string("the compiled graph doesn't match the network: ") + outputFileName);
+	} catch (std :: exception &e) {
+		cerr << "Error: " << e.what() << endl;
+		exit(1);
+	}
+	cerr << "compiled to " << outputFileName << endl;
+}
@@ -0,0 +1,109 @@
+#include "graph_view.hpp"
+#include <algorithm>
+#include <cassert>
+using namespace std;
+
+namespace graph_view {
+
+bool Graph :: are_connected(int32_t node_id1, int32_t node_id2) const {
+	Neighbours n1 = this->neighbours(node_id1);
+	Neighbours n2 = this->neighbours(node_id2);
+	if(n1.size() > n2.size()) {
+		swap(n1, n2);
+		swap(node_id1, node_id2);
+	}
+	return binary_search(n1.begin(), n1.end(), node_id2);
+}
+
+int32_t max_degree(const Graph *g) {
+	int32_t m = 0;
+	for(int32_t v = 0; v < g->numNodes(); v++)
+		m = max(m, g->degree(v));
+	return m;
+}
+
+static const int64_t no_offsets[] = { 0 };
+
+CsrGraph :: CsrGraph() : N(0), offsets(no_offsets), targets(NULL) {}
+
+CsrGraph :: CsrGraph(const Graph *g) : Graph(), N(0), offsets(no_offsets), targets(NULL) {
+	const int32_t num_nodes = g->numNodes();
+	vector<int64_t> o(num_nodes + 1);
+	o[0] = 0;
+	for(int32_t v = 0; v < num_nodes; v++)
+		o[v + 1] = o[v] + g->degree(v);
+	vector<int32_t> t;
+	t.reserve(o[num_nodes]);
+	for(int32_t v = 0; v < num_nodes; v++) {
+		const Neighbours neighs = g->neighbours(v);
+		t.insert(t.end(), neighs.begin(), neighs.end());
+	}
+	this->assign(o, t);
+}
+
+void CsrGraph :: assign(vector<int64_t> &o, vector<int32_t> &t) {
+	assert(!o.empty() && o.back() == int64_t(t.size()));
+	this->own_offsets.swap(o);
+	this->own_targets.swap(t);
+	this->N = int32_t(this->own_offsets.size() - 1);
+	this->offsets = &this->own_offsets.front();
+	this->targets = this->own_targets.empty() ? NULL : &this->own_targets.front();
+}
+
+void CsrGraph :: attach(int32_t num_nodes, const int64_t *o, const int32_t *t) {
+	this->own_offsets.clear();
+	this->own_targets.clear();
+	this->N = num_nodes;
+	this->offsets = o;
+	this->targets = t;
+}
+
+const uint64_t AdjacencyIndex :: EMPTY;
+
+AdjacencyIndex :: AdjacencyIndex(const Graph *g) : words_per_row(0), hubs(0), hub_row(g->numNodes(), -1), table_mask(0), table_shift(64) {
+	const int32_t N = g->numNodes();
+	const int32_t hub_degree = N / 128 > 1 ? N / 128 : 1;
+	this->words_per_row = (size_t(N) + 63) / 64;
+	for(int32_t v = 0; v < N; v++)
+		if(g->degree(v) >= hub_degree)
+			this->hub_row[v] = this->hubs++;
+	this->rows.resize(size_t(this->hubs) * this->words_per_row, 0);
+
+	size_t edges = 0; // between two nodes that aren't hubs
+	for(int32_t v = 0; v < N; v++) {
+		const Neighbours neighs = g->neighbours(v);
+		const int32_t row = this->hub_row[v];
+		for(Neighbours :: const_iterator w = neighs.begin(); w != neighs.end(); ++w) {
+			if(row >= 0)
+				this->rows[row * this->words_per_row + *w / 64] |= uint64_t(1) << (*w % 64);
+			else if(v < *w && this->hub_row[*w] < 0)
+				++ edges;
+		}
+	}
+
+	size_t capacity = 2;
+	int log2_capacity = 1;
+	while(capacity < 2 * edges) {
+		capacity *= 2;
+		++ log2_capacity;
+	}
+	this->table.resize(capacity, EMPTY);
+	this->table_mask = capacity - 1;
+	this->table_shift = 64 - log2_capacity;
+	for(int32_t v = 0; v < N; v++) {
+		if(this->hub_row[v] >= 0)
+			continue;
+		const Neighbours neighs = g->neighbours(v);
+		for(Neighbours :: const_iterator w = neighs.begin(); w != neighs.end(); ++w) {
+			if(v < *w && this->hub_row[*w] < 0) {
+				const uint64_t k = key(v, *w);
+				size_t slot = this->slot_of(k);
+				while(this->table[slot] != EMPTY && this->table[slot] != k)
+					slot = (slot + 1) & this->table_mask;
+				this->table[slot] = k;
+			}
+		}
+	}
+}
+
+} // namespace graph_view
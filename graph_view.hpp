@@ -0,0 +1,140 @@
+#ifndef _GRAPH_VIEW_HPP_
+#define _GRAPH_VIEW_HPP_
+
+#include "graph/network.hpp"
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+/*
+ * The graph, as the clique search sees it: just the nodes 0..numNodes()-1 and a sorted list of
+ * neighbours for each. No edge ids, and no names. That's enough for the search, and it lets us
+ * give the search a smaller graph (e.g. after dropping edges) with the same node ids,
+ * so the names still come from the original network.
+ */
+
+namespace graph_view {
+
+struct Neighbours { // a sorted run of node ids. The memory belongs to the graph
+	typedef const int32_t * const_iterator;
+	const int32_t *b;
+	const int32_t *e;
+	Neighbours() : b(NULL), e(NULL) {}
+	Neighbours(const int32_t *_b, const int32_t *_e) : b(_b), e(_e) {}
+	explicit Neighbours(const std :: vector<int32_t> &v) : b(v.empty() ? NULL : &v.front()), e(v.empty() ? NULL : &v.front() + v.size()) {}
+	const_iterator begin() const { return this->b; }
+	const_iterator end()   const { return this->e; }
+	size_t size()  const { return this->e - this->b; }
+	bool   empty() const { return this->e == this->b; }
+	const int32_t & operator[] (size_t i) const { return this->b[i]; }
+};
+
+struct Graph {
+	virtual int32_t numNodes() const = 0;
+	virtual Neighbours neighbours(int32_t node_id) const = 0;
+	virtual bool are_connected(int32_t node_id1, int32_t node_id2) const; // binary search in the shorter list
+	int32_t degree(int32_t node_id) const { return int32_t(this->neighbours(node_id).size()); }
+	virtual ~Graph() {}
+};
+
+int32_t max_degree(const Graph *g);
+
+struct NetworkView : public Graph { // a graph from lib_graph, as it is
+	const graph :: VerySimpleGraphInterface * const vsg;
+	explicit NetworkView(const graph :: VerySimpleGraphInterface *_vsg) : vsg(_vsg) {}
+	virtual int32_t numNodes() const { return this->vsg->numNodes(); }
+	virtual Neighbours neighbours(int32_t node_id) const { return Neighbours(this->vsg->neighbouring_nodes_in_order(node_id)); }
+	virtual bool are_connected(int32_t node_id1, int32_t node_id2) const { return this->vsg->are_connected(node_id1, node_id2); }
+};
+
+struct AdjacencyLists : public Graph { // a graph we made ourselves. Each list must be sorted
+	std :: vector< std :: vector<int32_t> > lists;
+	virtual int32_t numNodes() const { return int32_t(this->lists.size()); }
+	virtual Neighbours neighbours(int32_t node_id) const { return Neighbours(this->lists[node_id]); }
+};
+
+/*
+ * Compressed sparse row: every neighbour list back-to-back in one array, in node id order, with an offset per node.
+ * That's 4 bytes per neighbour and 8 per node, with no per-node heap block, and a scan over the nodes reads memory in order.
+ * The arrays are either our own, or someone else's (e.g. a mapped file) that must outlive the graph.
+ */
+class CsrGraph : public Graph {
+public:
+	CsrGraph(); // no nodes
+	explicit CsrGraph(const Graph *g); // a copy of g
+	void assign(std :: vector<int64_t> &offsets, std :: vector<int32_t> &targets); // takes the contents of both. offsets has numNodes+1 entries
+	void attach(int32_t num_nodes, const int64_t *offsets, const int32_t *targets); // uses these arrays, without copying them
+	virtual int32_t numNodes() const { return this->N; }
+	virtual Neighbours neighbours(int32_t node_id) const {
+		return Neighbours(this->targets + this->offsets[node_id], this->targets + this->offsets[node_id + 1]);
+	}
+	int64_t num_targets() const { return this->offsets[this->N]; } // twice the number of edges
+	size_t bytes() const { return sizeof(int64_t) * (size_t(this->N) + 1) + sizeof(int32_t) * size_t(this->num_targets()); }
+private:
+	int32_t N;
+	const int64_t *offsets;
+	const int32_t *targets;
+	std :: vector<int64_t> own_offsets;
+	std :: vector<int32_t> own_targets;
+	CsrGraph(const CsrGraph &);
+	CsrGraph & operator= (const CsrGraph &);
+};
+
+/*
+ * Adjacency tests without searching a neighbour list.
+ * The hubs, whose degree is at least numNodes/128, get a row of numNodes bits each; for them a bit costs less
+ * than an entry in the hash table would. The edges between the other nodes go in an open-addressing hash set,
+ * at most half full. Either way that's at most about 16 bytes per edge.
+ */
+class AdjacencyIndex {
+public:
+	explicit AdjacencyIndex(const Graph *g);
+	bool are_connected(int32_t node_id1, int32_t node_id2) const {
+		const int32_t row1 = this->hub_row[node_id1];
+		if(row1 >= 0)
+			return this->bit(row1, node_id2);
+		const int32_t row2 = this->hub_row[node_id2];
+		if(row2 >= 0)
+			return this->bit(row2, node_id1);
+		const uint64_t k = key(node_id1, node_id2);
+		for(size_t slot = this->slot_of(k); ; slot = (slot + 1) & this->table_mask) {
+			if(this->table[slot] == k)
+				return true;
+			if(this->table[slot] == EMPTY)
+				return false;
+		}
+	}
+	int32_t num_hubs() const { return this->hubs; }
+	size_t bytes() const { return sizeof(uint64_t) * (this->rows.size() + this->table.size()) + sizeof(int32_t) * this->hub_row.size(); }
+private:
+	static const uint64_t EMPTY = ~uint64_t(0);
+	size_t words_per_row;
+	int32_t hubs;
+	std :: vector<int32_t> hub_row; // the row of each hub, or -1
+	std :: vector<uint64_t> rows;
+	std :: vector<uint64_t> table;
+	size_t table_mask;
+	int table_shift;
+	bool bit(int32_t row, int32_t node_id) const {
+		return (this->rows[row * this->words_per_row + node_id / 64] >> (node_id % 64)) & 1;
+	}
+	static uint64_t key(int32_t a, int32_t b) {
+		return a < b ? (uint64_t(a) << 32) | uint32_t(b) : (uint64_t(b) << 32) | uint32_t(a);
+	}
+	size_t slot_of(uint64_t k) const {
+		return size_t((k * 0x9E3779B97F4A7C15ULL) >> this->table_shift);
+	}
+};
+
+struct IndexedGraph : public Graph { // another graph, with an AdjacencyIndex for are_connected()
+	const Graph * const g;
+	const AdjacencyIndex index;
+	explicit IndexedGraph(const Graph *_g) : g(_g), index(_g) {}
+	virtual int32_t numNodes() const { return this->g->numNodes(); }
+	virtual Neighbours neighbours(int32_t node_id) const { return this->g->neighbours(node_id); }
+	virtual bool are_connected(int32_t node_id1, int32_t node_id2) const { return this->index.are_connected(node_id1, node_id2); }
+};
+
+} // namespace graph_view
+
+#endif
@@ -0,0 +1,115 @@
+#include "incremental.hpp"
+#include <algorithm>
+#include <cassert>
+#include "macros.hpp"
+using namespace std;
+
+namespace incremental {
+
+int32_t CliqueSet :: add(const vector<int32_t> &clique) {
+	assert(!clique.empty());
+	int32_t id;
+	if(this->free_slots.empty()) {
+		id = int32_t(this->cliques.size());
+		this->cliques.push_back(clique);
+	} else {
+		id = this->free_slots.back();
+		this->free_slots.pop_back();
+		this->cliques.at(id) = clique;
+	}
+	For(v, clique) {
+		if(int32_t(this->cliques_of_node.size()) <= *v)
+			this->cliques_of_node.resize(*v + 1);
+		this->cliques_of_node[*v].push_back(id);
+	}
+	return id;
+}
+
+void CliqueSet :: remove(int32_t id) {
+	vector<int32_t> &clique = this->cliques.at(id);
+	assert(!clique.empty());
+	For(v, clique) {
+		vector<int32_t> &ids = this->cliques_of_node.at(*v);
+		vector<int32_t> :: iterator it = find(ids.begin(), ids.end(), id);
+		assert(it != ids.end());
+		*it = ids.back();
+		ids.pop_back();
+	}
+	vector<int32_t>().swap(clique);
+	this->free_slots.push_back(id);
+}
+
+void CliqueSet :: touching(const vector<int32_t> &nodes, vector<int32_t> &ids) const {
+	ids.clear();
+	For(v, nodes)
+		if(*v < int32_t(this->cliques_of_node.size()))
+			ids.insert(ids.end(), this->cliques_of_node[*v].begin(), this->cliques_of_node[*v].end());
+	sort(ids.begin(), ids.end());
+	ids.erase(unique(ids.begin(), ids.end()), ids.end());
+}
+
+static void insert_neighbour(vector<int32_t> &list, const int32_t v) {
+	vector<int32_t> :: iterator it = lower_bound(list.begin(), list.end(), v);
+	if(it == list.end() || *it != v)
+		list.insert(it, v);
+}
+static void erase_neighbour(vector<int32_t> &list, const int32_t v) {
+	vector<int32_t> :: iterator it = lower_bound(list.begin(), list.end(), v);
+	if(it != list.end() && *it == v)
+		list.erase(it);
+}
+
+void apply(graph_view :: AdjacencyLists &g
+		, CliqueSet &clique_set
+		, const vector<EdgeChange> &changes
+		, unsigned int minimumSize
+		, const cliques :: SearchOptions &options
+		, vector< vector<int32_t> > &appeared
+		, vector< vector<int32_t> > &disappeared) {
+	vector<int32_t> touched;
+	For(change, changes) {
+		if(change->u == change->v)
+			continue;
+		const int32_t biggest = max(change->u, change->v);
+		if(int32_t(g.lists.size()) <= biggest)
+			g.lists.resize(biggest + 1);
+		if(change->insert) {
+			insert_neighbour(g.lists.at(change->u), change->v);
+			insert_neighbour(g.lists.at(change->v), change->u);
+		} else {
+			erase_neighbour(g.lists.at(change->u), change->v);
+			erase_neighbour(g.lists.at(change->v), change->u);
+		}
+		touched.push_back(change->u);
+		touched.push_back(change->v);
+	}
+	sort(touched.begin(), touched.end());
+	touched.erase(unique(touched.begin(), touched.end()), touched.end());
+
+	vector< vector<int32_t> > fresh; // the cliques touching the changes, as they are now
+	if(!touched.empty())
+		cliques :: cliquesAroundNodesToVector(&g, touched, minimumSize, fresh, options);
+	sort(fresh.begin(), fresh.end());
+
+	vector<int32_t> old_ids; // ... and as they were
+	clique_set.touching(touched, old_ids);
+	vector< vector<int32_t> > still_there;
+	For(id, old_ids) {
+		const vector<int32_t> &clique = clique_set.cliques.at(*id);
+		if(binary_search(fresh.begin(), fresh.end(), clique))
+			still_there.push_back(clique);
+		else {
+			disappeared.push_back(clique);
+			clique_set.remove(*id);
+		}
+	}
+	sort(still_there.begin(), still_there.end());
+	For(clique, fresh) {
+		unless(binary_search(still_there.begin(), still_there.end(), *clique)) {
+			appeared.push_back(*clique);
+			clique_set.add(*clique);
+		}
+	}
+}
+
+} // namespace incremental
@@ -0,0 +1,52 @@
+#ifndef _INCREMENTAL_HPP_
+#define _INCREMENTAL_HPP_
+
+#include "graph_view.hpp"
+#include "cliques.hpp"
+#include <vector>
+
+/*
+ * Keeping the maximal cliques up to date as edges come and go.
+ *
+ * Every clique that appears or disappears, because of a batch of edge changes, contains
+ * an end point of one of the changed edges. (If a clique avoids all of them, none of its own edges changed,
+ * and a node that could newly extend it would need a new edge to one of its nodes.)
+ * So we only look at the persisted cliques that touch those end points, and re-enumerate only the cliques that
+ * contain one of them, with cliques :: cliquesAroundNodesToVector. The difference between the two is the update.
+ */
+
+namespace incremental {
+
+struct CliqueSet { // the maximal cliques, each sorted, with an index from every node to the cliques it's in
+	std :: vector< std :: vector<int32_t> > cliques; // a removed clique leaves an empty slot, to be reused
+	std :: vector< std :: vector<int32_t> > cliques_of_node; // clique ids
+	std :: vector<int32_t> free_slots;
+	int64_t size() const { return int64_t(this->cliques.size()) - int64_t(this->free_slots.size()); }
+	int32_t add(const std :: vector<int32_t> &clique); // must be sorted. Returns its id
+	void remove(int32_t id);
+	void touching(const std :: vector<int32_t> &nodes, std :: vector<int32_t> &ids) const; // the ids of the cliques with at least one of the nodes
+};
+
+struct EdgeChange {
+	int32_t u, v;
+	bool insert; // or delete
+	EdgeChange(int32_t _u, int32_t _v, bool _insert) : u(_u), v(_v), insert(_insert) {}
+};
+
+/*
+ * Apply the changes, in order, to g and then bring clique_set up to date.
+ * g may grow, if a change mentions a node it doesn't have yet. Inserting an edge that's there already,
+ * or deleting one that isn't, does nothing. Self-loops are ignored.
+ * 'appeared' and 'disappeared' get the cliques added to, and removed from, clique_set.
+ */
+void apply(graph_view :: AdjacencyLists &g
+		, CliqueSet &clique_set
+		, const std :: vector<EdgeChange> &changes
+		, unsigned int minimumSize
+		, const cliques :: SearchOptions &options
+		, std :: vector< std :: vector<int32_t> > &appeared
+		, std :: vector< std :: vector<int32_t> > &disappeared);
+
+} // namespace incremental
+
+#endif
@@ -1,13 +1,14 @@
 using namespace std;
 #include "graph/network.hpp"
-#include "graph/loading.hpp"
-#include "graph/stats.hpp"
 #include <getopt.h>
 #include <libgen.h>
 #include <ctime>
+#include <stdexcept>
+#include <fstream>
 
 #include "macros.hpp"
 #include "cliques.hpp"
+#include "shard.hpp"
 #include "cmdline.h"
 
 int option_minCliqueSize = 3;
@@ -19,29 +20,102 @@ int main(int argc, char **argv) {
 	if (cmdline_parser (argc, argv, &args_info) != 0)
 		exit(1) ;
 	// .. and there should be exactly one non-option arg
-	if(args_info.inputs_num != 1 || args_info.k_arg < 3) {
+	if(args_info.inputs_num != 1 || args_info.k_arg < 3 || args_info.threads_arg < 1 || args_info.top_arg < 0
+			|| args_info.checkpoint_seconds_arg < 1 || args_info.root_report_top_arg < 1 || (args_info.checkpoint_given && !args_info.output_given)) {
 		cmdline_parser_print_help();
 		exit(1);
 	}
+	if(args_info.count_only_flag && (args_info.output_given || args_info.checkpoint_given || args_info.resume_flag)) {
+		cerr << "Error: --count-only doesn't write the cliques, so it can't take --output, --checkpoint or --resume" << endl;
+		exit(1);
+	}
+	if(args_info.maximum_flag && (args_info.shard_given || args_info.output_given || args_info.checkpoint_given || args_info.resume_flag)) {
+		cerr << "Error: --maximum searches the whole graph, and prints to stdout, so it can't take --shard, --output, --checkpoint or --resume" << endl;
+		exit(1);
+	}
+	if(args_info.top_arg > 0 && (args_info.checkpoint_given || args_info.resume_flag)) {
+		cerr << "Error: --top keeps the cliques until the search is over, so it can't take --checkpoint or --resume" << endl;
+		exit(1);
+	}
 
 	const char * edgeListFileName   = args_info.inputs[0];
 	const int k = args_info.k_arg;
 
-        std :: auto_ptr<graph :: NetworkInterfaceConvertedToString > network;
-	if(args_info.stringIDs_flag) {
-		network	= graph :: loading :: make_Network_from_edge_list_string(edgeListFileName, false, false, true);
-	} else {
-		network	= graph :: loading :: make_Network_from_edge_list_int64(edgeListFileName, false, false, true, 0);
+	compiled_graph :: Loaded loaded; // the network, or a compiled graph (see graph-compile), or one parsed with --parallel-load
+	try {
+		compiled_graph :: load(edgeListFileName, args_info.stringIDs_flag, args_info.parallel_load_flag ? args_info.threads_arg : 0, loaded);
+	} catch (std :: exception &e) {
+		cerr << "Error: " << e.what() << endl;
+		exit(1);
 	}
+	const compiled_graph :: Input input = loaded.input();
 
-	int32_t maxDegree = graph :: stats :: get_max_degree(network->get_plain_graph());
+	int32_t maxDegree = graph_view :: max_degree(input.graph());
 	cerr << "Network loaded"
 	       << " after " << (double(clock()) / CLOCKS_PER_SEC) << " seconds. "
-		<< network.get()->numNodes() << " nodes and " << network.get()->numRels() << " edges."
+		<< input.numNodes() << " nodes and " << input.numRels() << " edges."
 		<< " Max degree is " << maxDegree
 	       << endl;
 
 	// cliques::cliquesToStdout(g.get(), k);
-	cliques :: cliquesToStdout(network.get(), k);
+	cliques :: SearchOptions options;
+	options.num_threads = args_info.threads_arg;
+	options.degeneracy_order = args_info.degeneracy_flag;
+	options.truss = args_info.truss_flag;
+	options.csr = args_info.csr_flag;
+	options.adjacency_index = args_info.adjacency_index_flag;
+	options.root_report = args_info.root_report_given ? args_info.root_report_arg : NULL;
+	options.root_report_top = args_info.root_report_top_arg;
+	unless(relabel :: parse(args_info.relabel_arg, options.relabel)) {
+		cerr << "Error: --relabel should be none, degree, rcm or bfs, not " << args_info.relabel_arg << endl;
+		exit(1);
+	}
+	if(args_info.shard_given) {
+		unless(shard :: parse(args_info.shard_arg, options.shard, options.num_shards)) {
+			cerr << "Error: --shard should be i/n, with 0 <= i < n, not " << args_info.shard_arg << endl;
+			exit(1);
+		}
+	}
+	try {
+		if(args_info.maximum_flag) {
+			std :: vector<int32_t> clique;
+			cliques :: maximumClique(input.graph(), clique, options);
+			cerr << "maximum clique size: " << clique.size() << endl;
+			for(size_t i = 0; i < clique.size(); i++)
+				cout << (i ? " " : "") << input.node_name(clique.at(i));
+			cout << endl;
+		} else if(args_info.top_arg > 0) {
+			std :: vector< std :: vector<int32_t> > top;
+			cliques :: cliquesTopToVector(input, k, args_info.top_arg, top, options);
+			cerr << top.size() << " cliques kept" << endl;
+			ofstream output_file;
+			if(args_info.output_given) {
+				output_file.open(args_info.output_arg);
+				unless(output_file)
+					throw std :: runtime_error(string("can't write to ") + args_info.output_arg);
+			}
+			ostream &out = args_info.output_given ? output_file : cout;
+			for(size_t c = 0; c < top.size(); c++) {
+				for(size_t i = 0; i < top.at(c).size(); i++)
+					out << (i ? " " : "") << input.node_name(top.at(c).at(i));
+				out << '\n';
+			}
+			out << flush;
+			unless(out)
+				throw std :: runtime_error(string("failed to write ") + (args_info.output_given ? args_info.output_arg : "the cliques"));
+		} else if(args_info.count_only_flag)
+			cliques :: cliquesCountOnly(input, k, options);
+		else {
+			cliques :: OutputOptions output;
+			output.output_file = args_info.output_given ? args_info.output_arg : NULL;
+			output.checkpoint_file = args_info.checkpoint_given ? args_info.checkpoint_arg : NULL;
+			output.checkpoint_seconds = args_info.checkpoint_seconds_arg;
+			output.resume = args_info.resume_flag;
+			cliques :: cliquesToStdout(input, k, options, output);
+		}
+	} catch (std :: exception &e) { // the output file, the checkpoint, or the root report
+		cerr << "Error: " << e.what() << endl;
+		exit(1);
+	}
 
 }
@@ -0,0 +1,249 @@
+#include "cliques.hpp"
+#include "parallel.hpp"
+#include "ordering.hpp"
+#include "graph_view.hpp"
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <pthread.h>
+#include "macros.hpp"
+using namespace std;
+
+/*
+ * The maximum clique, by branch and bound, in the style of BBMC (San Segundo et al.) and MCS (Tomita et al.)
+ *
+ * Each root v, taken in degeneracy order, is searched for cliques made of v and its neighbours *later* in the order.
+ * There are at most 'degeneracy' of those, and they become a small dense subproblem with an adjacency matrix of bitsets.
+ * In the subproblem, a greedy coloring of the Candidates bounds the size of any clique among them,
+ * as no two nodes in a clique can share a color. We try the Candidates in decreasing order of color,
+ * and stop as soon as the colors can't beat the biggest clique found so far.
+ *
+ * The roots are taken from the end of the order (the densest core) first, so that a big clique is found early
+ * and the bound prunes most of the other roots before anything is built for them.
+ */
+
+namespace cliques {
+
+typedef int32_t V;
+typedef const graph_view :: Graph * SearchGraph;
+typedef graph_view :: Neighbours Neighbours;
+typedef uint64_t word;
+static const int32_t WORD_BITS = 64;
+
+struct MaximumShared {
+	SearchGraph g;
+	vector<int32_t> order, position, core_number;
+	pthread_mutex_t best_lock;
+	volatile int32_t best_size; // read without the lock. It only ever grows, and it's only used to prune
+	vector<int32_t> best_clique;
+};
+
+struct MaximumThread { // a subproblem, and the scratch space for searching it. One per thread, reused for every root
+	MaximumShared &shared;
+	int32_t best_size; // this thread's copy of shared.best_size. Refreshed at every root
+	vector<int32_t> local_index; // for each node in the graph, its index in the current subproblem, or -1
+	vector<int32_t> local_to_global;
+	int32_t n, W; // nodes, and words per row, in the subproblem
+	vector<word> adjacency; // row i is adjacency[i*W] ... adjacency[i*W+W-1]
+	vector< vector<word> > P_at_depth; // the Candidates at each depth
+	vector< vector<int32_t> > nodes_at_depth, colors_at_depth; // the colored Candidates at each depth, in increasing order of color
+	vector<word> uncolored, color_class;
+	vector<int32_t> current; // the clique being grown, as local indices (the root isn't included)
+	V root;
+
+	MaximumThread(MaximumShared &_shared) : shared(_shared), best_size(0)
+		, local_index(_shared.g->numNodes(), -1), n(0), W(0) {}
+	const word * row(int32_t i) const { return &this->adjacency[size_t(i) * this->W]; }
+	void build(const V v, const vector<int32_t> &candidates);
+	void expand(const size_t depth);
+	void color(const size_t depth);
+	void found(const size_t depth);
+};
+
+static inline bool any_bits(const word *b, const int32_t W) {
+	for(int32_t w = 0; w < W; w++)
+		if(b[w])
+			return true;
+	return false;
+}
+
+void MaximumThread :: build(const V v, const vector<int32_t> &candidates) {
+	const SearchGraph &g = this->shared.g;
+	this->root = v;
+	this->n = int32_t(candidates.size());
+	this->W = (this->n + WORD_BITS - 1) / WORD_BITS;
+
+	// bits are assigned in decreasing order of degree within the subproblem, as the coloring takes the lowest bit first
+	vector< pair<int32_t, V> > by_degree;
+	For(c, candidates)
+		this->local_index.at(*c) = 0;
+	For(c, candidates) {
+		int32_t local_degree = 0;
+		const Neighbours neighs = g->neighbours(*c);
+		For(w, neighs)
+			if(this->local_index[*w] == 0)
+				++ local_degree;
+		by_degree.push_back(make_pair(-local_degree, *c));
+	}
+	sort(by_degree.begin(), by_degree.end());
+	this->local_to_global.resize(this->n);
+	for(int32_t i = 0; i < this->n; i++) {
+		this->local_to_global[i] = by_degree[i].second;
+		this->local_index[by_degree[i].second] = i;
+	}
+
+	this->adjacency.assign(size_t(this->n) * this->W, 0);
+	for(int32_t i = 0; i < this->n; i++) {
+		word *r = &this->adjacency[size_t(i) * this->W];
+		const Neighbours neighs = g->neighbours(this->local_to_global[i]);
+		For(w, neighs) {
+			const int32_t j = this->local_index[*w];
+			if(j >= 0 && j != i)
+				r[j / WORD_BITS] |= word(1) << (j % WORD_BITS);
+		}
+	}
+	For(c, candidates)
+		this->local_index.at(*c) = -1;
+}
+
+void MaximumThread :: color(const size_t depth) {
+	// Greedy coloring of the Candidates. We only keep those whose color is high enough to possibly beat the best clique
+	const int32_t W = this->W;
+	const vector<word> &P = this->P_at_depth[depth];
+	vector<int32_t> &nodes = this->nodes_at_depth[depth];
+	vector<int32_t> &colors = this->colors_at_depth[depth];
+	nodes.clear();
+	colors.clear();
+	const int32_t color_needed = this->best_size - 1 - int32_t(this->current.size()); // 1 for the root
+	this->uncolored.assign(P.begin(), P.begin() + W);
+	this->color_class.resize(W);
+	int32_t k = 0;
+	while(any_bits(&this->uncolored.front(), W)) {
+		++ k;
+		copy(this->uncolored.begin(), this->uncolored.end(), this->color_class.begin());
+		for(int32_t w = 0; w < W; w++) {
+			while(this->color_class[w]) {
+				const int32_t i = w * WORD_BITS + __builtin_ctzll(this->color_class[w]);
+				const word *r = this->row(i);
+				this->color_class[w] &= this->color_class[w] - 1;
+				this->uncolored[w] &= ~(word(1) << (i % WORD_BITS));
+				for(int32_t w2 = w; w2 < W; w2++) // the bits below i have already been taken
+					this->color_class[w2] &= ~r[w2];
+				if(k > color_needed) {
+					nodes.push_back(i);
+					colors.push_back(k);
+				}
+			}
+		}
+	}
+}
+
+void MaximumThread :: found(const size_t depth) {
+	const int32_t size = int32_t(depth) + 1;
+	pthread_mutex_lock(&this->shared.best_lock);
+	if(size > this->shared.best_size) {
+		this->shared.best_clique.clear();
+		this->shared.best_clique.push_back(this->root);
+		For(i, this->current)
+			this->shared.best_clique.push_back(this->local_to_global[*i]);
+		this->shared.best_size = size;
+	}
+	this->best_size = this->shared.best_size;
+	pthread_mutex_unlock(&this->shared.best_lock);
+}
+
+void MaximumThread :: expand(const size_t depth) {
+	// current.size() == depth, and P_at_depth[depth] are the Candidates
+	assert(this->current.size() == depth);
+	assert(this->P_at_depth.size() >= depth + 2); // the caller made room for every depth. We hold references into these
+	const int32_t W = this->W;
+	this->P_at_depth[depth+1].resize(W);
+	this->color(depth);
+	const vector<int32_t> &nodes = this->nodes_at_depth[depth];
+	const vector<int32_t> &colors = this->colors_at_depth[depth];
+	for(size_t x = nodes.size(); x > 0; x--) {
+		if(int32_t(depth) + 1 + colors[x-1] <= this->best_size)
+			return; // not even the colors left can beat the best clique
+		const int32_t i = nodes[x-1];
+		word *P = &this->P_at_depth[depth].front();
+		word *next = &this->P_at_depth[depth+1].front();
+		const word *r = this->row(i);
+		for(int32_t w = 0; w < W; w++)
+			next[w] = P[w] & r[w];
+		this->current.push_back(i);
+		if(any_bits(next, W))
+			this->expand(depth + 1);
+		else if(int32_t(depth) + 2 > this->best_size)
+			this->found(depth + 1);
+		this->current.pop_back();
+		P[i / WORD_BITS] &= ~(word(1) << (i % WORD_BITS));
+	}
+}
+
+struct MaximumRoots : public parallel :: IndexedTask {
+	MaximumShared &shared;
+	vector<MaximumThread *> threads;
+	MaximumRoots(MaximumShared &_shared, int num_threads) : shared(_shared) {
+		for(int t = 0; t < num_threads; t++)
+			this->threads.push_back(new MaximumThread(_shared));
+	}
+	~MaximumRoots() {
+		For(t, this->threads)
+			delete *t;
+	}
+	virtual void run(int64_t i, int thread_id) {
+		MaximumThread &t = *this->threads.at(thread_id);
+		const SearchGraph &g = this->shared.g;
+		const V v = this->shared.order.at(g->numNodes() - 1 - i);
+		t.best_size = this->shared.best_size;
+		if(this->shared.core_number[v] + 1 <= t.best_size)
+			return;
+		vector<int32_t> candidates; // the later neighbours, that might be in a clique bigger than the best
+		const Neighbours neighs = g->neighbours(v);
+		For(w, neighs)
+			if(this->shared.position[*w] > this->shared.position[v] && this->shared.core_number[*w] >= t.best_size)
+				candidates.push_back(*w);
+		if(int32_t(candidates.size()) + 1 <= t.best_size)
+			return;
+		if(candidates.empty()) {
+			t.current.clear();
+			t.root = v;
+			t.found(0);
+			return;
+		}
+		t.build(v, candidates);
+		if(t.P_at_depth.size() < size_t(t.n) + 2) { // the clique can't be deeper than the number of Candidates
+			t.P_at_depth.resize(t.n + 2);
+			t.nodes_at_depth.resize(t.n + 2);
+			t.colors_at_depth.resize(t.n + 2);
+		}
+		t.P_at_depth[0].assign(t.W, 0);
+		for(int32_t j = 0; j < t.n; j++)
+			t.P_at_depth[0][j / WORD_BITS] |= word(1) << (j % WORD_BITS);
+		t.current.clear();
+		t.expand(0);
+	}
+};
+
+void maximumClique(SimpleIntGraph vsg, std :: vector<int32_t> &clique, const SearchOptions &options) {
+	const graph_view :: NetworkView view(vsg);
+	maximumClique(&view, clique, options);
+}
+
+void maximumClique(const SearchGraph g, std :: vector<int32_t> &clique, const SearchOptions &options) {
+	const int num_threads = options.num_threads < 1 ? 1 : options.num_threads;
+	MaximumShared shared;
+	shared.g = g;
+	ordering :: degeneracy_order(g, shared.order, shared.position, shared.core_number);
+	pthread_mutex_init(&shared.best_lock, NULL);
+	shared.best_size = 0;
+	{
+		MaximumRoots roots(shared, num_threads);
+		parallel :: for_each_index(g->numNodes(), num_threads, roots);
+	}
+	pthread_mutex_destroy(&shared.best_lock);
+	clique.swap(shared.best_clique);
+	sort(clique.begin(), clique.end());
+}
+
+} // namespace cliques
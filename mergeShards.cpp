@@ -0,0 +1,141 @@
+using namespace std;
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "macros.hpp"
+#include "shard.hpp"
+#include "cmdline-mergeShards.h"
+
+/*
+ * Each shard's output (from justTheCliques --shard i/n) ends with a shard :: Trailer, written only once
+ * the shard is complete. We check that every shard of 0 ... n-1 is there exactly once, complete, with
+ * as many cliques as its trailer says, and that they're all from the same search.
+ * Only then are the cliques written, without the trailers. Nothing is written if any check fails.
+ */
+
+struct ShardFile {
+	const char *file_name;
+	shard :: Trailer trailer;
+};
+
+static bool check_one(const char *file_name, shard :: Trailer &trailer) { // prints the problem, if there is one
+	ifstream in(file_name);
+	unless(in) {
+		cerr << "Error: can't read " << file_name << endl;
+		return false;
+	}
+	string line;
+	int64_t cliques = 0;
+	bool finished = false; // have we seen the trailer?
+	while(getline(in, line)) {
+		if(finished) {
+			cerr << "Error: " << file_name << " has more after its trailer" << endl;
+			return false;
+		}
+		if(!line.empty() && line[0] == '#') {
+			unless(trailer.from_string(line)) {
+				cerr << "Error: " << file_name << " has a comment that isn't a shard trailer: " << line << endl;
+				return false;
+			}
+			finished = true;
+		} else
+			++ cliques;
+	}
+	unless(finished) {
+		cerr << "Error: " << file_name << " has no trailer, so that shard didn't finish" << endl;
+		return false;
+	}
+	unless(trailer.num_shards > 0 && 0 <= trailer.shard && trailer.shard < trailer.num_shards) {
+		cerr << "Error: " << file_name << " has a trailer for shard " << trailer.shard << '/' << trailer.num_shards << ", which can't be" << endl;
+		return false;
+	}
+	unless(cliques == trailer.cliques) {
+		cerr << "Error: " << file_name << " has " << cliques << " cliques, but its trailer says " << trailer.cliques << endl;
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char **argv) {
+	gengetopt_args_info args_info;
+
+	// there shouldn't be any errors in processing args
+	if (cmdline_parser (argc, argv, &args_info) != 0)
+		exit(1) ;
+	// .. and there should be at least one non-option arg
+	if(args_info.inputs_num < 1) {
+		cmdline_parser_print_help();
+		exit(1);
+	}
+
+	vector<ShardFile> shards;
+	bool ok = true;
+	for(unsigned int i = 0; i < args_info.inputs_num; i++) {
+		ShardFile f;
+		f.file_name = args_info.inputs[i];
+		if(check_one(f.file_name, f.trailer))
+			shards.push_back(f);
+		else
+			ok = false;
+	}
+
+	if(!shards.empty()) {
+		const shard :: Trailer &first = shards.front().trailer;
+		vector<const char *> file_of_shard(first.num_shards, (const char *) NULL);
+		For(f, shards) {
+			const shard :: Trailer &t = f->trailer;
+			unless(t.num_shards == first.num_shards && t.num_nodes == first.num_nodes
+					&& t.minimum_size == first.minimum_size && t.degeneracy_order == first.degeneracy_order && t.relabel == first.relabel
+					&& t.truss == first.truss) {
+				cerr << "Error: " << f->file_name << " is from a different search than " << shards.front().file_name << endl;
+				ok = false;
+				continue;
+			}
+			if(file_of_shard.at(t.shard)) {
+				cerr << "Error: shard " << t.shard << " is in both " << file_of_shard.at(t.shard) << " and " << f->file_name << endl;
+				ok = false;
+				continue;
+			}
+			file_of_shard.at(t.shard) = f->file_name;
+		}
+		for(int s = 0; s < first.num_shards; s++)
+			unless(file_of_shard.at(s)) {
+				cerr << "Error: shard " << s << '/' << first.num_shards << " is missing" << endl;
+				ok = false;
+			}
+	}
+	unless(ok)
+		exit(1);
+
+	int64_t total = 0;
+	For(f, shards)
+		total += f->trailer.cliques;
+	cerr << "all " << shards.size() << " shards are complete, with " << total << " cliques" << endl;
+	if(args_info.check_only_flag)
+		return 0;
+
+	ofstream output_file;
+	if(args_info.output_given) {
+		output_file.open(args_info.output_arg);
+		unless(output_file) {
+			cerr << "Error: can't write to " << args_info.output_arg << endl;
+			exit(1);
+		}
+	}
+	ostream &out = args_info.output_given ? output_file : cout;
+	For(f, shards) {
+		ifstream in(f->file_name);
+		string line;
+		while(getline(in, line))
+			if(line.empty() || line[0] != '#')
+				out << line << '\n';
+	}
+	out << flush;
+	unless(out) {
+		cerr << "Error: failed to write the cliques" << endl;
+		exit(1);
+	}
+}
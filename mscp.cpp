@@ -1,8 +1,8 @@
 #include "graph/network.hpp"
-#include "graph/loading.hpp"
-#include "graph/stats.hpp"
 #include "macros.hpp"
 #include "cliques.hpp"
+#include "graph_view.hpp"
+#include "relabel.hpp"
 #include "cmdline-mscp.h"
 #include "comments.hh"
 
@@ -32,7 +32,8 @@ using namespace std;
 
 typedef vector<int32_t> clique; // the nodes will be in increasing numerical order
 
-static void nonMaxCliques(const graph :: VerySimpleGraphInterface *vsg, const int32_t k);
+static void nonMaxCliques(const graph_view :: Graph *g, const int32_t k);
+static const int32_t *original_ids = NULL; // if the graph is relabeled, the node ids to print
 template<typename T>
 string thou(T number);
 
@@ -72,23 +73,42 @@ int main(int argc, char **argv) {
 	const char * output_file_name   = args_info.inputs[1];
 	PP3(args_info.k_arg, edgeListFileName, output_file_name);
 
-        std :: auto_ptr<graph :: NetworkInterfaceConvertedToString > network;
-	if(args_info.stringIDs_flag) {
-		network	= graph :: loading :: make_Network_from_edge_list_string(edgeListFileName, false, false, true);
-	} else {
-		network	= graph :: loading :: make_Network_from_edge_list_int64(edgeListFileName, false, false, true, 0);
+	compiled_graph :: Loaded loaded; // the network, or a compiled graph (see graph-compile)
+	try {
+		compiled_graph :: load(edgeListFileName, args_info.stringIDs_flag, 0, loaded);
+	} catch (std :: exception &e) {
+		cerr << "Error: " << e.what() << endl;
+		exit(1);
 	}
+	const compiled_graph :: Input input = loaded.input();
 
-	int32_t maxDegree = graph :: stats :: get_max_degree(network->get_plain_graph());
+	int32_t maxDegree = graph_view :: max_degree(input.graph());
 
 	cerr << "Network loaded"
 	       << " after " << (double(clock()) / CLOCKS_PER_SEC) << " seconds. "
-		<< network.get()->numNodes() << " nodes and " << network.get()->numRels() << " edges."
+		<< input.numNodes() << " nodes and " << input.numRels() << " edges."
 		<< " Max degree is " << maxDegree
 	       << endl;
 
+	relabel :: Order order;
+	unless(relabel :: parse(args_info.relabel_arg, order)) {
+		cerr << "Error: --relabel should be none, degree, rcm or bfs, not " << args_info.relabel_arg << endl;
+		exit(1);
+	}
+	const graph_view :: Graph *g = input.graph();
+	std :: auto_ptr<relabel :: RelabeledGraph> relabeled;
+	std :: auto_ptr<graph_view :: CsrGraph> csr;
+	if(order != relabel :: NONE) { // a relabeled graph is a CsrGraph already
+		relabeled.reset(new relabel :: RelabeledGraph(g, order));
+		g = relabeled.get();
+		original_ids = relabeled->old_of_new.empty() ? NULL : &relabeled->old_of_new.front();
+	} else if(args_info.csr_flag && !loaded.csr) { // a CsrNetwork is one already
+		csr.reset(new graph_view :: CsrGraph(g));
+		g = csr.get();
+	}
+
 	// finally, call the clique_percolation algorithm proper
-	nonMaxCliques(network->get_plain_graph(), args_info.k_arg);
+	nonMaxCliques(g, args_info.k_arg);
 }
 
 template<typename T>
@@ -100,24 +120,24 @@ string thou(T number) {
 }
 
 
-static void readyToTryOneNode(vector<int32_t> &, const vector<int32_t> &cands, const graph :: VerySimpleGraphInterface * vsg, const int32_t k);
+static void readyToTryOneNode(vector<int32_t> &, const vector<int32_t> &cands, const graph_view :: Graph * g, const int32_t k);
 
-static void nonMaxCliques(const graph :: VerySimpleGraphInterface *vsg, const int32_t k) {
-	const int32_t N = vsg->numNodes();
+static void nonMaxCliques(const graph_view :: Graph *g, const int32_t k) {
+	const int32_t N = g->numNodes();
 	for(int32_t n=0; n<N; n++) {
 		/* try cliques around every node, using its *lower-degree* neighbours as candidates.
 		 * if same degree, keep higher-id nodes
 		 */
-		const int32_t degree_of_n = vsg->degree(n);
+		const int32_t degree_of_n = g->degree(n);
 		if(degree_of_n < k)
 			continue;
 		vector<int32_t> clique;
 		clique.push_back(n);
 		vector<int32_t> candidate_nodes;
-		const std :: vector<int32_t> &neighs = vsg -> neighbouring_nodes_in_order(n);
+		const graph_view :: Neighbours neighs = g->neighbours(n);
 		For(neigh, neighs) {
 			assert(*neigh != n);
-			const int32_t degree_of_neighbour = vsg->degree(*neigh);
+			const int32_t degree_of_neighbour = g->degree(*neigh);
 			if(degree_of_neighbour < k)
 				continue;
 			if(degree_of_neighbour > degree_of_n)
@@ -128,40 +148,44 @@ static void nonMaxCliques(const graph :: VerySimpleGraphInterface *vsg, const in
 		}
 		if(1 + candidate_nodes.size() < (size_t)k)
 			continue;
-		readyToTryOneNode(clique, candidate_nodes, vsg, k);
+		readyToTryOneNode(clique, candidate_nodes, g, k);
 	}
 }
 
 static void find_cliques(vector<int32_t> &clique
 		, vector<int32_t> cands
-		, const graph :: VerySimpleGraphInterface * vsg
+		, const graph_view :: Graph * g
 		, const int32_t k);
 
 static void move_node_in( vector<int32_t> &clique
 		, const vector<int32_t> &cands
-		, const graph :: VerySimpleGraphInterface * vsg
+		, const graph_view :: Graph * g
 		, const int32_t k
 		, const int32_t node_to_move_in
 		) {
 	clique.push_back(node_to_move_in);
 	// delete nodes from cands unless they are connected to node_to_move_in
-	const std :: vector<int32_t> &neighs = vsg -> neighbouring_nodes_in_order(node_to_move_in);
+	const graph_view :: Neighbours neighs = g->neighbours(node_to_move_in);
 	vector<int32_t> new_cands;
 	set_intersection (cands.begin(), cands.end()
 			, neighs.begin(), neighs.end()
 			, back_inserter(new_cands)
 			);
-	find_cliques(clique, new_cands, vsg, k);
+	find_cliques(clique, new_cands, g, k);
 	clique.pop_back();
 }
 
 
 static void find_cliques(vector<int32_t> &clique
 		, vector<int32_t> cands
-		, const graph :: VerySimpleGraphInterface * vsg
+		, const graph_view :: Graph * g
 		, const int32_t k) {
 	if(clique.size() == (size_t)k) {
-		For(clique_node, clique) {
+		vector<int32_t> in_original_ids;
+		For(clique_node, clique)
+			in_original_ids.push_back(original_ids ? original_ids[*clique_node] : *clique_node);
+		sort(in_original_ids.begin(), in_original_ids.end());
+		For(clique_node, in_original_ids) {
 			cerr << *clique_node << " ";
 		}
 		cerr << endl;
@@ -179,13 +203,13 @@ static void find_cliques(vector<int32_t> &clique
 		/* this is the main bit of the algorithm,
 		 * we must try find_cliques twice: once with, and once without, the arbitrary node
 		 */
-		move_node_in(clique, cands, vsg, k, arbitrary_next_node_to_eject);
+		move_node_in(clique, cands, g, k, arbitrary_next_node_to_eject);
 
 		cands.pop_back(); // remove arbitrary_next_node_to_eject from cands
 	}
 }
 
-static void readyToTryOneNode(vector<int32_t> &clique, const vector<int32_t> &cands, const graph :: VerySimpleGraphInterface * vsg, const int32_t k) {
+static void readyToTryOneNode(vector<int32_t> &clique, const vector<int32_t> &cands, const graph_view :: Graph * g, const int32_t k) {
 	assert(clique.size()==1);
-	find_cliques(clique, cands, vsg, k);
+	find_cliques(clique, cands, g, k);
 }
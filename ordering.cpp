@@ -0,0 +1,97 @@
+#include "ordering.hpp"
+#include <cassert>
+using namespace std;
+
+namespace ordering {
+
+void degeneracy_order(const graph_view :: Graph *g
+		, vector<int32_t> &order
+		, vector<int32_t> &position
+		, vector<int32_t> &core_number) {
+	const int32_t N = g->numNodes();
+	vector<int32_t> &deg = core_number; // the current degrees become the core numbers as we peel
+	deg.resize(N);
+	int32_t max_degree = 0;
+	for(int32_t v = 0; v < N; v++) {
+		deg.at(v) = g->degree(v);
+		if(max_degree < deg.at(v))
+			max_degree = deg.at(v);
+	}
+
+	// bucket sort the nodes by degree. bin[d] is where the nodes of degree d begin in 'order'
+	vector<int32_t> bin(max_degree + 1, 0);
+	for(int32_t v = 0; v < N; v++)
+		++ bin.at(deg.at(v));
+	int32_t start = 0;
+	for(int32_t d = 0; d <= max_degree; d++) {
+		const int32_t num = bin.at(d);
+		bin.at(d) = start;
+		start += num;
+	}
+	order.resize(N);
+	position.resize(N);
+	for(int32_t v = 0; v < N; v++) {
+		position.at(v) = bin.at(deg.at(v));
+		order.at(position.at(v)) = v;
+		++ bin.at(deg.at(v));
+	}
+	for(int32_t d = max_degree; d > 0; d--)
+		bin.at(d) = bin.at(d-1);
+	bin.at(0) = 0;
+
+	// peel the nodes in order. When v goes, each neighbour of higher degree moves down one bucket
+	for(int32_t i = 0; i < N; i++) {
+		const int32_t v = order.at(i);
+		const graph_view :: Neighbours neighs = g->neighbours(v);
+		for(graph_view :: Neighbours :: const_iterator it = neighs.begin(); it != neighs.end(); ++it) {
+			const int32_t u = *it;
+			if(deg.at(u) > deg.at(v)) {
+				const int32_t du = deg.at(u);
+				const int32_t pu = position.at(u);
+				const int32_t pw = bin.at(du);
+				const int32_t w = order.at(pw);
+				if(u != w) { // swap u to the front of its bucket
+					order.at(pu) = w;
+					position.at(w) = pu;
+					order.at(pw) = u;
+					position.at(u) = pw;
+				}
+				++ bin.at(du);
+				-- deg.at(u);
+			}
+		}
+	}
+}
+
+int32_t k_core(const graph_view :: Graph *g
+		, const int32_t k
+		, vector<char> &in_core) {
+	const int32_t N = g->numNodes();
+	vector<int32_t> deg(N);
+	vector<int32_t> doomed; // removed from the core, but their neighbours' degrees haven't been reduced yet
+	in_core.assign(N, 1);
+	int32_t remaining = N;
+	for(int32_t v = 0; v < N; v++) {
+		deg.at(v) = g->degree(v);
+		if(deg.at(v) < k) {
+			in_core.at(v) = 0;
+			doomed.push_back(v);
+		}
+	}
+	while(!doomed.empty()) {
+		const int32_t v = doomed.back();
+		doomed.pop_back();
+		-- remaining;
+		const graph_view :: Neighbours neighs = g->neighbours(v);
+		for(graph_view :: Neighbours :: const_iterator it = neighs.begin(); it != neighs.end(); ++it) {
+			const int32_t u = *it;
+			if(in_core.at(u) && -- deg.at(u) < k) {
+				in_core.at(u) = 0;
+				doomed.push_back(u);
+			}
+		}
+	}
+	return remaining;
+}
+
+} // namespace ordering
@@ -0,0 +1,31 @@
+#ifndef _ORDERING_HPP_
+#define _ORDERING_HPP_
+
+#include "graph_view.hpp"
+#include <vector>
+
+namespace ordering {
+
+/*
+ * Core decomposition, by the bucket algorithm of Batagelj and Zaversnik, in O(nodes+edges).
+ * order[i] is the i-th node to be peeled; every node has at most core_number[node] neighbours
+ * later in the order, and never more than the degeneracy of the graph.
+ * position is the inverse of order.
+ */
+void degeneracy_order(const graph_view :: Graph *g
+		, std :: vector<int32_t> &order
+		, std :: vector<int32_t> &position
+		, std :: vector<int32_t> &core_number);
+
+/*
+ * The k-core: repeatedly remove the nodes with fewer than k neighbours left.
+ * in_core[v] is 1 for the nodes that remain, 0 for the rest. Returns how many remain. O(nodes+edges).
+ * No clique of size k+1 or more has any node outside the k-core.
+ */
+int32_t k_core(const graph_view :: Graph *g
+		, int32_t k
+		, std :: vector<char> &in_core);
+
+} // namespace ordering
+
+#endif
@@ -0,0 +1,190 @@
+#include "parallel.hpp"
+#include <vector>
+#include <deque>
+#include <cassert>
+#include <pthread.h>
+#include "macros.hpp"
+using namespace std;
+
+namespace parallel {
+
+struct range { // the indices [next, end) that nobody has claimed yet from one thread's share
+	pthread_mutex_t lock;
+	int64_t next;
+	int64_t end;
+	char padding[64]; // keep each thread's range on its own cache line
+};
+
+struct loop_state : public Spawner {
+	vector<range> ranges;
+	IndexedTask *body;
+
+	// the spawned tasks, and the threads waiting for them
+	pthread_mutex_t tasks_lock;
+	pthread_cond_t tasks_changed;
+	deque<Task *> tasks;
+	int running; // how many threads there are
+	int idle; // how many of them are waiting in next_task()
+	bool finished; // every thread is idle, and there are no tasks. Nothing can spawn more
+	volatile int hunger; // idle - tasks.size(), for hungry()
+
+	virtual bool hungry() const { return this->hunger > 0; }
+	virtual void spawn(Task *task) {
+		pthread_mutex_lock(&this->tasks_lock);
+		this->tasks.push_back(task);
+		this->hunger = this->idle - int(this->tasks.size());
+		pthread_cond_signal(&this->tasks_changed);
+		pthread_mutex_unlock(&this->tasks_lock);
+	}
+	Task * next_task() { // for a thread that has run out of indices. NULL once everything is finished
+		pthread_mutex_lock(&this->tasks_lock);
+		++ this->idle;
+		this->hunger = this->idle - int(this->tasks.size());
+		while(this->tasks.empty() && !this->finished) {
+			if(this->idle == this->running) {
+				this->finished = true;
+				pthread_cond_broadcast(&this->tasks_changed);
+			} else
+				pthread_cond_wait(&this->tasks_changed, &this->tasks_lock);
+		}
+		Task *task = NULL;
+		if(!this->tasks.empty()) {
+			task = this->tasks.front();
+			this->tasks.pop_front();
+			-- this->idle;
+		}
+		this->hunger = this->idle - int(this->tasks.size());
+		pthread_mutex_unlock(&this->tasks_lock);
+		return task;
+	}
+	void fewer_threads(int started) { // some threads couldn't be started
+		pthread_mutex_lock(&this->tasks_lock);
+		this->running = started;
+		pthread_cond_broadcast(&this->tasks_changed); // perhaps they're all idle already
+		pthread_mutex_unlock(&this->tasks_lock);
+	}
+};
+
+struct thread_arg {
+	loop_state *s;
+	int thread_id;
+};
+
+static bool claim_from_own_range(range &r, int64_t &i) {
+	pthread_mutex_lock(&r.lock);
+	const bool found = r.next < r.end;
+	if(found)
+		i = r.next++;
+	pthread_mutex_unlock(&r.lock);
+	return found;
+}
+
+static bool steal(loop_state &s, const int thief) {
+	// find the thread with the most unclaimed indices, and take the upper half of them
+	const int T = int(s.ranges.size());
+	for(int attempt = 0; attempt < 2; attempt++) { // the victim might run dry between looking and stealing
+		int victim = -1;
+		int64_t most_remaining = 0;
+		for(int offset = 1; offset < T; offset++) {
+			const int t = (thief + offset) % T;
+			range &r = s.ranges.at(t);
+			pthread_mutex_lock(&r.lock);
+			const int64_t remaining = r.end - r.next;
+			pthread_mutex_unlock(&r.lock);
+			if(remaining > most_remaining) {
+				most_remaining = remaining;
+				victim = t;
+			}
+		}
+		if(victim == -1)
+			return false; // nothing left anywhere
+		range &v = s.ranges.at(victim);
+		int64_t stolen_begin = 0, stolen_end = 0;
+		pthread_mutex_lock(&v.lock);
+		const int64_t remaining = v.end - v.next;
+		if(remaining > 0) {
+			stolen_begin = v.next + remaining / 2;
+			stolen_end = v.end;
+			v.end = stolen_begin;
+		}
+		pthread_mutex_unlock(&v.lock);
+		if(stolen_begin < stolen_end) {
+			range &mine = s.ranges.at(thief);
+			pthread_mutex_lock(&mine.lock);
+			assert(mine.next == mine.end);
+			mine.next = stolen_begin;
+			mine.end = stolen_end;
+			pthread_mutex_unlock(&mine.lock);
+			return true;
+		}
+	}
+	return false;
+}
+
+static void * worker(void *arg_) {
+	const thread_arg *arg = static_cast<const thread_arg *>(arg_);
+	loop_state &s = *arg->s;
+	range &mine = s.ranges.at(arg->thread_id);
+	while(1) {
+		int64_t i;
+		while(claim_from_own_range(mine, i))
+			s.body->run(i, arg->thread_id);
+		if(steal(s, arg->thread_id))
+			continue;
+		Task *task = s.next_task();
+		unless(task)
+			break;
+		task->run(arg->thread_id);
+		delete task;
+	}
+	return NULL;
+}
+
+void for_each_index(int64_t n, int num_threads, IndexedTask &body) {
+	if(num_threads <= 1) {
+		for(int64_t i = 0; i < n; i++)
+			body.run(i, 0);
+		return;
+	}
+
+	loop_state s;
+	s.body = &body;
+	pthread_mutex_init(&s.tasks_lock, NULL);
+	pthread_cond_init(&s.tasks_changed, NULL);
+	s.running = num_threads;
+	s.idle = 0;
+	s.finished = false;
+	s.hunger = 0;
+	body.spawner = &s;
+	s.ranges.resize(num_threads);
+	for(int t = 0; t < num_threads; t++) {
+		range &r = s.ranges.at(t);
+		pthread_mutex_init(&r.lock, NULL);
+		r.next = n * t / num_threads;
+		r.end = n * (t+1) / num_threads;
+	}
+
+	vector<thread_arg> args(num_threads);
+	vector<pthread_t> threads(num_threads);
+	for(int t = 0; t < num_threads; t++) {
+		args.at(t).s = &s;
+		args.at(t).thread_id = t;
+	}
+	int started = 1;
+	while(started < num_threads && 0 == pthread_create(&threads.at(started), NULL, worker, &args.at(started)))
+		++ started; // if we can't start them all, the others will steal the work of the missing threads
+	if(started < num_threads)
+		s.fewer_threads(started);
+	worker(&args.at(0)); // the calling thread is thread 0
+	for(int t = 1; t < started; t++)
+		pthread_join(threads.at(t), NULL);
+	body.spawner = NULL;
+	assert(s.tasks.empty());
+	pthread_cond_destroy(&s.tasks_changed);
+	pthread_mutex_destroy(&s.tasks_lock);
+
+	for(int t = 0; t < num_threads; t++)
+		pthread_mutex_destroy(&s.ranges.at(t).lock);
+}
+
+} // namespace parallel
@@ -0,0 +1,52 @@
+#ifndef _PARALLEL_HPP_
+#define _PARALLEL_HPP_
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace parallel {
+
+/*
+ * A piece of work split off from an IndexedTask, to be run by whichever thread is idle.
+ */
+struct Task {
+	virtual void run(int thread_id) = 0;
+	virtual ~Task() {}
+};
+
+/*
+ * How the body of a loop splits off Tasks. Every task spawned is run, by some thread, before
+ * for_each_index returns. Tasks may spawn more tasks.
+ */
+struct Spawner {
+	virtual bool hungry() const = 0; // is a thread idle, with no task waiting for it? Only a hint, as it's read without a lock
+	virtual void spawn(Task *task) = 0; // takes ownership of the task, and deletes it once it has run
+	virtual ~Spawner() {}
+};
+
+/*
+ * The body of a parallel loop. run(i, thread_id) is called exactly once for
+ * every i in [0,n), from one of the threads 0 <= thread_id < num_threads.
+ * While the loop runs, 'spawner' lets run() split off Tasks. It's NULL with only one thread.
+ */
+struct IndexedTask {
+	Spawner *spawner;
+	IndexedTask() : spawner(NULL) {}
+	virtual void run(int64_t i, int thread_id) = 0;
+	virtual ~IndexedTask() {}
+};
+
+/*
+ * Work-stealing loop over [0,n). Each thread starts with a contiguous block of
+ * the indices and takes them one at a time from the front. When its own block is
+ * empty it steals the upper half of the largest remaining block of another thread.
+ * This copes with a few very expensive indices (e.g. hub vertices) far better
+ * than static chunking does.
+ * Once no indices are left, the threads run the spawned Tasks, and wait for more until every thread is idle.
+ * With num_threads <= 1, everything runs in the calling thread, in order.
+ */
+void for_each_index(int64_t n, int num_threads, IndexedTask &body);
+
+} // namespace parallel
+
+#endif
@@ -0,0 +1,124 @@
+#include "relabel.hpp"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <cassert>
+#include "macros.hpp"
+using namespace std;
+
+namespace relabel {
+
+bool parse(const char *text, Order &order) {
+	static const Order orders[] = { NONE, DEGREE, RCM, BFS };
+	for(size_t i = 0; i < sizeof(orders) / sizeof(orders[0]); i++)
+		if(0 == strcmp(text, name(orders[i]))) {
+			order = orders[i];
+			return true;
+		}
+	return false;
+}
+
+const char * name(Order order) {
+	switch(order) {
+		case NONE:   return "none";
+		case DEGREE: return "degree";
+		case RCM:    return "rcm";
+		case BFS:    return "bfs";
+	}
+	return "?";
+}
+
+struct ByDegree { // ties are broken by node id, so that the order is the same every time
+	const graph_view :: Graph *g;
+	const bool descending;
+	ByDegree(const graph_view :: Graph *_g, bool _descending) : g(_g), descending(_descending) {}
+	bool operator() (int32_t l, int32_t r) const {
+		const int32_t dl = this->g->degree(l);
+		const int32_t dr = this->g->degree(r);
+		if(dl != dr)
+			return this->descending ? dl > dr : dl < dr;
+		return l < r;
+	}
+};
+
+static void breadth_first(const graph_view :: Graph *g, const bool from_low_degree, vector<int32_t> &order) {
+	// one BFS per component, each from the lowest (or highest) degree node not yet visited. With from_low_degree,
+	// the neighbours are visited in increasing order of degree, as Cuthill-McKee does; otherwise in id order
+	const int32_t N = g->numNodes();
+	vector<int32_t> starts(N);
+	for(int32_t v = 0; v < N; v++)
+		starts[v] = v;
+	sort(starts.begin(), starts.end(), ByDegree(g, !from_low_degree));
+	vector<char> visited(N, 0);
+	vector<int32_t> next;
+	For(start, starts) {
+		if(visited[*start])
+			continue;
+		visited[*start] = 1;
+		size_t head = order.size();
+		order.push_back(*start);
+		while(head < order.size()) {
+			const int32_t v = order[head++];
+			next.clear();
+			const graph_view :: Neighbours neighs = g->neighbours(v);
+			For(w, neighs)
+				unless(visited[*w]) {
+					visited[*w] = 1;
+					next.push_back(*w);
+				}
+			if(from_low_degree)
+				sort(next.begin(), next.end(), ByDegree(g, false));
+			order.insert(order.end(), next.begin(), next.end());
+		}
+	}
+}
+
+void compute_order(const graph_view :: Graph *g, Order order, vector<int32_t> &order_out) {
+	const int32_t N = g->numNodes();
+	order_out.clear();
+	order_out.reserve(N);
+	switch(order) {
+		case NONE:
+			for(int32_t v = 0; v < N; v++)
+				order_out.push_back(v);
+			break;
+		case DEGREE:
+			for(int32_t v = 0; v < N; v++)
+				order_out.push_back(v);
+			sort(order_out.begin(), order_out.end(), ByDegree(g, true));
+			break;
+		case RCM:
+			breadth_first(g, true, order_out);
+			reverse(order_out.begin(), order_out.end());
+			break;
+		case BFS:
+			breadth_first(g, false, order_out);
+			break;
+	}
+	assert(int32_t(order_out.size()) == N);
+}
+
+RelabeledGraph :: RelabeledGraph(const graph_view :: Graph *g, Order order) {
+	const int32_t N = g->numNodes();
+	compute_order(g, order, this->old_of_new);
+	this->new_of_old.resize(N);
+	for(int32_t v = 0; v < N; v++)
+		this->new_of_old[this->old_of_new[v]] = v;
+	vector<int64_t> offsets(N + 1);
+	offsets[0] = 0;
+	for(int32_t v = 0; v < N; v++)
+		offsets[v + 1] = offsets[v] + g->degree(this->old_of_new[v]);
+	vector<int32_t> targets(offsets[N]);
+	for(int32_t v = 0; v < N; v++) {
+		const graph_view :: Neighbours neighs = g->neighbours(this->old_of_new[v]);
+		if(neighs.empty())
+			continue;
+		int32_t *out = &targets.front() + offsets[v];
+		For(w, neighs)
+			*out++ = this->new_of_old[*w];
+		sort(&targets.front() + offsets[v], out);
+	}
+	this->assign(offsets, targets);
+}
+
+} // namespace relabel
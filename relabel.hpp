@@ -0,0 +1,36 @@
+#ifndef _RELABEL_HPP_
+#define _RELABEL_HPP_
+
+#include "graph_view.hpp"
+#include <vector>
+
+/*
+ * Renumbering the nodes, so that the neighbour lists the search reads together sit together in memory.
+ * The node ids from the loader are just the order the nodes appeared in the edge list.
+ *  - degree: highest degree first, so the hubs, which are in most neighbourhoods, share a few cache lines
+ *  - rcm:    reverse Cuthill-McKee, a BFS from a low-degree node, visiting the lower-degree neighbours
+ *            first, then reversed. Each node's neighbours get ids close to its own
+ *  - bfs:    a plain BFS from the highest-degree node of each component
+ * The relabeled graph is a graph_view :: CsrGraph, so its neighbour lists are back-to-back, in order of the new ids.
+ * The search finds its cliques in the new ids; old_of_new turns them back, so the output is unchanged.
+ */
+
+namespace relabel {
+
+enum Order { NONE, DEGREE, RCM, BFS };
+
+bool parse(const char *name, Order &order); // "none", "degree", "rcm" or "bfs". Returns false for anything else
+const char * name(Order order);
+
+/* order[i] is the node that gets new id i */
+void compute_order(const graph_view :: Graph *g, Order order, std :: vector<int32_t> &order_out);
+
+struct RelabeledGraph : public graph_view :: CsrGraph { // in the new ids
+	std :: vector<int32_t> old_of_new;
+	std :: vector<int32_t> new_of_old;
+	RelabeledGraph(const graph_view :: Graph *g, Order order);
+};
+
+} // namespace relabel
+
+#endif
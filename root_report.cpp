@@ -0,0 +1,82 @@
+#include "root_report.hpp"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <sys/time.h>
+#include "macros.hpp"
+using namespace std;
+
+namespace root_report {
+
+static bool took_longer(const RootCost &l, const RootCost &r) {
+	return l.seconds > r.seconds;
+}
+
+TopRoots :: TopRoots(size_t _N) : N(_N) {
+	this->total.root = 0;
+	this->total.seconds = 0;
+	this->total.search_nodes = 0;
+	this->total.cliques = 0;
+}
+
+void TopRoots :: add(const RootCost &cost) {
+	++ this->total.root;
+	this->total.seconds += cost.seconds;
+	this->total.search_nodes += cost.search_nodes;
+	this->total.cliques += cost.cliques;
+	if(this->heap.size() < this->N) {
+		this->heap.push_back(cost);
+		push_heap(this->heap.begin(), this->heap.end(), took_longer);
+	} else if(!this->heap.empty() && cost.seconds > this->heap.front().seconds) {
+		pop_heap(this->heap.begin(), this->heap.end(), took_longer);
+		this->heap.back() = cost;
+		push_heap(this->heap.begin(), this->heap.end(), took_longer);
+	}
+}
+
+void TopRoots :: merge(const TopRoots &other) {
+	const RootCost total_before = this->total;
+	For(cost, other.heap)
+		this->add(*cost);
+	this->total = total_before; // add() counted these again
+	this->total.root += other.total.root;
+	this->total.seconds += other.total.seconds;
+	this->total.search_nodes += other.total.search_nodes;
+	this->total.cliques += other.total.cliques;
+}
+
+void TopRoots :: heaviest(vector<RootCost> &out) const {
+	out = this->heap;
+	sort(out.begin(), out.end(), took_longer);
+}
+
+double now() {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return double(tv.tv_sec) + double(tv.tv_usec) / 1e6;
+}
+
+void write(const char *file_name, const TopRoots &roots, const compiled_graph :: Input &input, const graph_view :: Graph *g, const int32_t *original_ids) {
+	ofstream out(file_name);
+	vector<RootCost> heaviest;
+	roots.heaviest(heaviest);
+	const RootCost &total = roots.totals();
+	out << "# the " << heaviest.size() << " heaviest of " << total.root << " roots, by wall time. All the roots took "
+		<< total.seconds << " seconds, " << total.search_nodes << " search nodes and " << total.cliques << " cliques\n";
+	out << "#rank\tname\tdegree\tseconds\tsearch_nodes\tcliques\n";
+	for(size_t i = 0; i < heaviest.size(); i++) {
+		const RootCost &cost = heaviest.at(i);
+		out << i + 1
+			<< '\t' << input.node_name(original_ids ? original_ids[cost.root] : cost.root)
+			<< '\t' << g->degree(cost.root)
+			<< '\t' << cost.seconds
+			<< '\t' << cost.search_nodes
+			<< '\t' << cost.cliques
+			<< '\n';
+	}
+	out.close();
+	unless(out)
+		throw std :: runtime_error(string("failed to write the root report to ") + file_name);
+}
+
+} // namespace root_report
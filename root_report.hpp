@@ -0,0 +1,47 @@
+#ifndef _ROOT_REPORT_HPP_
+#define _ROOT_REPORT_HPP_
+
+#include "compiled_graph.hpp"
+#include "graph_view.hpp"
+#include <vector>
+
+/*
+ * What each root of the search cost, to find the few hubs that can make a run take hours.
+ * Each thread keeps its own TopRoots, and they're merged at the end.
+ */
+
+namespace root_report {
+
+struct RootCost {
+	int32_t root;
+	double seconds; // wall time
+	int64_t search_nodes; // calls to cliquesWorker and cliquesWorkerBitset
+	int64_t cliques;
+};
+
+class TopRoots { // the N roots that took longest, and the totals over every root
+public:
+	explicit TopRoots(size_t N);
+	void add(const RootCost &cost);
+	void merge(const TopRoots &other);
+	void heaviest(std :: vector<RootCost> &out) const; // longest first
+	const RootCost & totals() const { return this->total; } // 'root' is how many roots there were
+	size_t capacity() const { return this->N; }
+private:
+	size_t N;
+	std :: vector<RootCost> heap; // the quickest of the N is at the front
+	RootCost total;
+};
+
+double now(); // seconds, from gettimeofday
+
+/*
+ * A tab-separated report: rank, name, degree, seconds, search nodes and cliques, for each of the heaviest roots.
+ * The degree is in 'g', the graph that was searched. If g is relabeled, original_ids gives the node ids in 'input'.
+ * Throws std :: runtime_error if the file can't be written.
+ */
+void write(const char *file_name, const TopRoots &roots, const compiled_graph :: Input &input, const graph_view :: Graph *g, const int32_t *original_ids = NULL);
+
+} // namespace root_report
+
+#endif
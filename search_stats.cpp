@@ -0,0 +1,76 @@
+#include "search_stats.hpp"
+using namespace std;
+
+namespace search_stats {
+
+Counters :: Counters()
+	: bitset_kernels(0), intersections(0), intersection_input(0), intersection_neighbours(0), intersection_output(0)
+	, are_connected_calls(0), pivots(0), pivot_candidates(0), pivot_fewest_disc(0), not_dominates_exits(0), subtrees_split(0) {}
+
+void Counters :: pivot(size_t candidates, int32_t fewest_disc, bool in_not) {
+	++ this->pivots;
+	this->pivot_candidates += candidates;
+	this->pivot_fewest_disc += fewest_disc;
+	size_t bucket = 0;
+	while(fewest_disc >> bucket)
+		++ bucket;
+	if(this->fewest_disc_log2.size() <= bucket)
+		this->fewest_disc_log2.resize(bucket + 1);
+	++ this->fewest_disc_log2[bucket];
+	if(in_not && fewest_disc == 0)
+		++ this->not_dominates_exits;
+}
+
+static void add_into(vector<int64_t> &total, const vector<int64_t> &more) {
+	if(total.size() < more.size())
+		total.resize(more.size());
+	for(size_t i = 0; i < more.size(); i++)
+		total[i] += more[i];
+}
+
+void Counters :: add(const Counters &other) {
+	add_into(this->worker_calls, other.worker_calls);
+	add_into(this->bitset_worker_calls, other.bitset_worker_calls);
+	this->bitset_kernels += other.bitset_kernels;
+	this->intersections += other.intersections;
+	this->intersection_input += other.intersection_input;
+	this->intersection_neighbours += other.intersection_neighbours;
+	this->intersection_output += other.intersection_output;
+	this->are_connected_calls += other.are_connected_calls;
+	this->pivots += other.pivots;
+	this->pivot_candidates += other.pivot_candidates;
+	this->pivot_fewest_disc += other.pivot_fewest_disc;
+	add_into(this->fewest_disc_log2, other.fewest_disc_log2);
+	this->not_dominates_exits += other.not_dominates_exits;
+	this->subtrees_split += other.subtrees_split;
+}
+
+static void write_array(ostream &out, const vector<int64_t> &a) {
+	out << '[';
+	for(size_t i = 0; i < a.size(); i++)
+		out << (i ? "," : "") << a[i];
+	out << ']';
+}
+
+void Counters :: write_json(ostream &out) const {
+	out << "{\"worker_calls_by_depth\":";
+	write_array(out, this->worker_calls);
+	out << ",\"bitset_worker_calls_by_depth\":";
+	write_array(out, this->bitset_worker_calls);
+	out << ",\"bitset_kernels\":" << this->bitset_kernels
+		<< ",\"intersections\":" << this->intersections
+		<< ",\"intersection_input\":" << this->intersection_input
+		<< ",\"intersection_neighbours\":" << this->intersection_neighbours
+		<< ",\"intersection_output\":" << this->intersection_output
+		<< ",\"are_connected_calls\":" << this->are_connected_calls
+		<< ",\"pivots\":" << this->pivots
+		<< ",\"pivot_candidates\":" << this->pivot_candidates
+		<< ",\"pivot_fewest_disc\":" << this->pivot_fewest_disc
+		<< ",\"fewest_disc_log2\":";
+	write_array(out, this->fewest_disc_log2);
+	out << ",\"not_dominates_exits\":" << this->not_dominates_exits
+		<< ",\"subtrees_split\":" << this->subtrees_split
+		<< "}\n";
+}
+
+} // namespace search_stats
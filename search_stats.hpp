@@ -0,0 +1,60 @@
+#ifndef _SEARCH_STATS_HPP_
+#define _SEARCH_STATS_HPP_
+
+#include <vector>
+#include <ostream>
+#include <stdint.h>
+
+/*
+ * Counters for the hot paths of the search in cliques.cpp, to see why a graph is slow.
+ * They're only compiled in with -DCLIQUE_STATS (make STATS=-DCLIQUE_STATS); otherwise CLIQUE_STAT(...)
+ * expands to nothing, and the search is exactly as it was.
+ * Each thread counts into its own Counters, which are added up at the end, so there's no sharing.
+ */
+#ifdef CLIQUE_STATS
+#define CLIQUE_STAT(x) x
+#else
+#define CLIQUE_STAT(x)
+#endif
+
+namespace search_stats {
+
+struct Counters {
+	std :: vector<int64_t> worker_calls;        // calls to cliquesWorker, by depth (the size of Compsub)
+	std :: vector<int64_t> bitset_worker_calls; // ... and to cliquesWorkerBitset
+	int64_t bitset_kernels;                     // how many subtrees were handed to the bitset kernel
+	int64_t intersections;                      // by tryCandidate, two per call
+	int64_t intersection_input;                 // the total size of the Candidates/Not going into them
+	int64_t intersection_neighbours;            // ... and of the neighbour lists
+	int64_t intersection_output;                // ... and of what came out
+	int64_t are_connected_calls;
+	int64_t pivots;                             // in both engines
+	int64_t pivot_candidates;                   // the total Candidates at those pivots
+	int64_t pivot_fewest_disc;                  // ... and the total of fewestDisc, the branches the pivot leaves
+	std :: vector<int64_t> fewest_disc_log2;    // fewestDisc: [0] counts 0, [i] counts 2^(i-1) ... 2^i - 1
+	int64_t not_dominates_exits;                // a node in Not is connected to every Candidate (fewestDisc == 0)
+	int64_t subtrees_split;                     // branches handed to idle threads (see SubtreeTask)
+
+	Counters();
+	void worker_call       (size_t depth) { count_at(this->worker_calls, depth); }
+	void bitset_worker_call(size_t depth) { count_at(this->bitset_worker_calls, depth); }
+	void intersection(size_t input, size_t neighbours, size_t output) {
+		++ this->intersections;
+		this->intersection_input += input;
+		this->intersection_neighbours += neighbours;
+		this->intersection_output += output;
+	}
+	void pivot(size_t candidates, int32_t fewest_disc, bool in_not);
+	void add(const Counters &other);
+	void write_json(std :: ostream &out) const; // one line
+private:
+	static void count_at(std :: vector<int64_t> &counts, size_t i) {
+		if(counts.size() <= i)
+			counts.resize(i + 1);
+		++ counts[i];
+	}
+};
+
+} // namespace search_stats
+
+#endif
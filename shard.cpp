@@ -0,0 +1,115 @@
+#include "shard.hpp"
+#include <queue>
+#include <algorithm>
+#include <sstream>
+#include <cstdlib>
+#include "macros.hpp"
+using namespace std;
+
+namespace shard {
+
+bool parse(const char *text, int &shard, int &num_shards) {
+	char *end = NULL;
+	const long i = strtol(text, &end, 10);
+	unless(end != text && *end == '/')
+		return false;
+	const char *n_text = end + 1;
+	const long n = strtol(n_text, &end, 10);
+	unless(end != n_text && *end == '\0')
+		return false;
+	unless(0 <= i && i < n && n <= (1 << 20))
+		return false;
+	shard = int(i);
+	num_shards = int(n);
+	return true;
+}
+
+int64_t root_cost(const graph_view :: Graph *g, int32_t v, const vector<int32_t> &position, const vector<char> &in_core) {
+	unless(in_core[v])
+		return 0;
+	const int32_t v_position = position.empty() ? v : position[v];
+	int64_t candidates = 0, nots = 0;
+	const graph_view :: Neighbours neighs = g->neighbours(v);
+	For(w, neighs) {
+		unless(in_core[*w])
+			continue;
+		if((position.empty() ? *w : position[*w]) > v_position)
+			++ candidates;
+		else
+			++ nots;
+	}
+	if(candidates == 0)
+		return 0;
+	return 1 + candidates * (candidates + nots);
+}
+
+int64_t roots_of_shard(const graph_view :: Graph *g
+		, const vector<int32_t> &position
+		, const vector<char> &in_core
+		, int shard
+		, int num_shards
+		, vector<char> &in_shard) {
+	const int32_t N = g->numNodes();
+	vector< pair<int64_t, int32_t> > roots; // (cost, node), most expensive first
+	for(int32_t v = 0; v < N; v++) {
+		const int64_t cost = root_cost(g, v, position, in_core);
+		if(cost > 0)
+			roots.push_back(make_pair(-cost, v));
+	}
+	sort(roots.begin(), roots.end()); // the node ids break the ties, so every process sorts the same way
+
+	// the roots that cost nothing are spread round-robin below; they're only skipped anyway
+	in_shard.assign(N, 0);
+	for(int32_t v = 0; v < N; v++)
+		if(v % num_shards == shard)
+			in_shard[v] = 1;
+
+	priority_queue< pair<int64_t, int>, vector< pair<int64_t, int> >, greater< pair<int64_t, int> > > load; // (cost so far, shard), least first
+	for(int s = 0; s < num_shards; s++)
+		load.push(make_pair(0, s));
+	int64_t cost_of_this_shard = 0;
+	For(root, roots) {
+		pair<int64_t, int> least = load.top();
+		load.pop();
+		least.first += -root->first;
+		in_shard[root->second] = least.second == shard;
+		if(least.second == shard)
+			cost_of_this_shard = least.first;
+		load.push(least);
+	}
+	return cost_of_this_shard;
+}
+
+string Trailer :: to_string() const {
+	ostringstream line;
+	line << "# shard " << this->shard << '/' << this->num_shards
+		<< " nodes " << this->num_nodes
+		<< " k " << this->minimum_size
+		<< " degeneracy " << (this->degeneracy_order ? 1 : 0)
+		<< " relabel " << this->relabel
+		<< " truss " << (this->truss ? 1 : 0)
+		<< " cliques " << this->cliques
+		<< " complete\n";
+	return line.str();
+}
+
+bool Trailer :: from_string(const string &line) {
+	istringstream fields(line);
+	string hash, shard_key, nodes_key, k_key, degeneracy_key, relabel_key, truss_key, cliques_key, complete;
+	char slash = 0;
+	int degeneracy = 0, truss = 0;
+	fields >> hash >> shard_key >> this->shard >> slash >> this->num_shards
+		>> nodes_key >> this->num_nodes
+		>> k_key >> this->minimum_size
+		>> degeneracy_key >> degeneracy
+		>> relabel_key >> this->relabel
+		>> truss_key >> truss
+		>> cliques_key >> this->cliques
+		>> complete;
+	this->degeneracy_order = degeneracy != 0;
+	this->truss = truss != 0;
+	return fields && hash == "#" && shard_key == "shard" && slash == '/' && nodes_key == "nodes" && k_key == "k"
+		&& degeneracy_key == "degeneracy" && relabel_key == "relabel" && truss_key == "truss" && cliques_key == "cliques" && complete == "complete";
+}
+
+} // namespace shard
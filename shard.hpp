@@ -0,0 +1,57 @@
+#ifndef _SHARD_HPP_
+#define _SHARD_HPP_
+
+#include "graph_view.hpp"
+#include <vector>
+#include <string>
+
+/*
+ * Splitting one enumeration over many processes. Each root owns the cliques in which it comes first
+ * in the order, so any partition of the roots partitions the cliques, and the shards' outputs can
+ * simply be concatenated.
+ * The roots aren't split into ranges of node ids, as the expensive ones tend to be clustered.
+ * Instead each root gets an estimated cost, and the roots are dealt out, most expensive first,
+ * to the shard with the least cost so far. Every process computes the same partition.
+ */
+
+namespace shard {
+
+bool parse(const char *text, int &shard, int &num_shards); // "i/n", with 0 <= i < n. Returns false if it's malformed
+
+/*
+ * The estimated cost of searching from v: the pivot engine, in the first frame, compares the
+ * (Candidates + Not) with the Candidates. It's zero for the roots that needn't be searched at all.
+ */
+int64_t root_cost(const graph_view :: Graph *g, int32_t v, const std :: vector<int32_t> &position, const std :: vector<char> &in_core);
+
+/*
+ * in_shard[v] is 1 iff root v belongs to 'shard' (of 0 ... num_shards-1). Returns the shard's estimated cost.
+ * 'position' is the order of the roots (empty for node id order), and in_core the nodes worth searching, as in cliques.cpp
+ */
+int64_t roots_of_shard(const graph_view :: Graph *g
+		, const std :: vector<int32_t> &position
+		, const std :: vector<char> &in_core
+		, int shard
+		, int num_shards
+		, std :: vector<char> &in_shard);
+
+/*
+ * The last line of a shard's output. It's only written once the shard is complete, and it starts with '#',
+ * so that it's ignored in a cliques file. See mergeShards.cpp
+ */
+struct Trailer {
+	int shard;
+	int num_shards;
+	int32_t num_nodes;
+	int32_t minimum_size;
+	bool degeneracy_order;
+	int relabel; // a relabel :: Order
+	bool truss; // the roots' costs are in the truss, if there is one, so it changes the partition
+	int64_t cliques;
+	std :: string to_string() const; // including the '\n'
+	bool from_string(const std :: string &line); // false if it isn't a trailer
+};
+
+} // namespace shard
+
+#endif
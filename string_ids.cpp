@@ -0,0 +1,60 @@
+#include "string_ids.hpp"
+#include <cstring>
+using namespace std;
+
+namespace string_ids {
+
+Interner :: Interner() : offsets(1, 0), slots(16, 0), mask(15) {}
+
+uint64_t Interner :: hash(const char *b, const char *e) { // FNV-1a
+	uint64_t h = 0xcbf29ce484222325ULL;
+	for(; b != e; ++b)
+		h = (h ^ uint8_t(*b)) * 0x100000001b3ULL;
+	return h;
+}
+
+int32_t Interner :: intern(const char *b, const char *e) {
+	const uint64_t tag = hash(b, e) >> 32 << 32;
+	const size_t length = e - b;
+	size_t slot = size_t(tag >> 32) & this->mask;
+	for(; this->slots[slot]; slot = (slot + 1) & this->mask) {
+		if((this->slots[slot] >> 32 << 32) != tag)
+			continue;
+		const int32_t id = int32_t(uint32_t(this->slots[slot]) - 1);
+		if(size_t(this->offsets[id+1] - this->offsets[id]) == length && (length == 0 || 0 == memcmp(this->name_begin(id), b, length)))
+			return id;
+	}
+	const int32_t id = this->size();
+	this->arena.insert(this->arena.end(), b, e);
+	this->offsets.push_back(int64_t(this->arena.size()));
+	this->slots[slot] = tag | uint64_t(uint32_t(id) + 1);
+	if(2 * size_t(this->size()) > this->slots.size())
+		this->grow();
+	return id;
+}
+
+void Interner :: grow() {
+	vector<uint64_t> old;
+	old.swap(this->slots);
+	this->slots.assign(2 * old.size(), 0);
+	this->mask = this->slots.size() - 1;
+	for(size_t i = 0; i < old.size(); i++) {
+		if(!old[i])
+			continue;
+		size_t slot = size_t(old[i] >> 32) & this->mask;
+		while(this->slots[slot])
+			slot = (slot + 1) & this->mask;
+		this->slots[slot] = old[i];
+	}
+}
+
+void Interner :: release(vector<char> &arena_out, vector<int64_t> &offsets_out) {
+	arena_out.swap(this->arena);
+	offsets_out.swap(this->offsets);
+	vector<char>().swap(this->arena);
+	this->offsets.assign(1, 0);
+	this->slots.assign(16, 0);
+	this->mask = 15;
+}
+
+} // namespace string_ids
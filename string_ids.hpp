@@ -0,0 +1,39 @@
+#ifndef _STRING_IDS_HPP_
+#define _STRING_IDS_HPP_
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+/*
+ * String node names, each stored once: the chars of every name back-to-back in one arena, with an offset per name,
+ * as writer :: NodeNames keeps them. Names are found again through an open-addressing hash table, at most half full,
+ * whose slots hold the name's id and 32 bits of its hash, so that a probe only reads the arena when the hashes match.
+ * That's the name's bytes, plus 8 bytes for its offset and 16 or so for its slots, with no allocation per name.
+ */
+
+namespace string_ids {
+
+class Interner {
+public:
+	Interner();
+	int32_t intern(const char *b, const char *e); // the id of the name [b,e). A new name gets the next id, from 0 up
+	int32_t size() const { return int32_t(this->offsets.size() - 1); }
+	const char * name_begin(int32_t id) const { return this->text() + this->offsets[id]; }
+	const char * name_end  (int32_t id) const { return this->text() + this->offsets[id+1]; }
+	void release(std :: vector<char> &arena_out, std :: vector<int64_t> &offsets_out); // hands over the names; the Interner is empty afterwards
+private:
+	std :: vector<char> arena;
+	std :: vector<int64_t> offsets; // name i is arena[offsets[i]] ... arena[offsets[i+1]-1]
+	std :: vector<uint64_t> slots; // (hash >> 32) << 32 | (id+1), or 0 if empty
+	size_t mask;
+	const char * text() const { return this->arena.empty() ? NULL : &this->arena.front(); }
+	static uint64_t hash(const char *b, const char *e);
+	void grow();
+	Interner(const Interner &);
+	Interner & operator= (const Interner &);
+};
+
+} // namespace string_ids
+
+#endif
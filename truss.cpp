@@ -0,0 +1,151 @@
+#include "truss.hpp"
+#include "ordering.hpp"
+#include "parallel.hpp"
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include "macros.hpp"
+using namespace std;
+
+namespace truss {
+
+/*
+ * Every edge appears twice, once in the list of each end point.
+ * Edge slot offsets[u]+i is the i-th neighbour of u. Both slots of an edge hold the same support.
+ */
+struct Slots {
+	const graph_view :: AdjacencyLists &g;
+	vector<int64_t> offsets;
+	Slots(const graph_view :: AdjacencyLists &_g) : g(_g), offsets(_g.lists.size() + 1, 0) {
+		for(size_t u = 0; u < _g.lists.size(); u++)
+			this->offsets[u+1] = this->offsets[u] + _g.lists[u].size();
+	}
+	int64_t slot(const int32_t u, const int32_t v) const { // where v is in the list of u
+		const vector<int32_t> &l = this->g.lists[u];
+		const vector<int32_t> :: const_iterator it = lower_bound(l.begin(), l.end(), v);
+		assert(it != l.end() && *it == v);
+		return this->offsets[u] + (it - l.begin());
+	}
+};
+
+struct CountTriangles : public parallel :: IndexedTask { // the support of every edge (u,v), with u < v, is counted from u
+	const Slots &slots;
+	vector<int32_t> &support;
+	CountTriangles(const Slots &_slots, vector<int32_t> &_support) : slots(_slots), support(_support) {}
+	virtual void run(int64_t u_, int) {
+		const int32_t u = int32_t(u_);
+		const vector<int32_t> &nu = this->slots.g.lists[u];
+		for(size_t i = 0; i < nu.size(); i++) {
+			const int32_t v = nu[i];
+			if(v < u)
+				continue;
+			const vector<int32_t> &nv = this->slots.g.lists[v];
+			int32_t triangles = 0;
+			vector<int32_t> :: const_iterator a = nu.begin(), b = nv.begin();
+			while(a != nu.end() && b != nv.end()) {
+				if(*a < *b)
+					++a;
+				else if(*b < *a)
+					++b;
+				else {
+					++ triangles;
+					++a;
+					++b;
+				}
+			}
+			this->support[this->slots.offsets[u] + i] = triangles;
+			this->support[this->slots.slot(v, u)] = triangles; // nobody else writes to either slot
+		}
+	}
+};
+
+int64_t k_truss(const graph_view :: Graph *g
+		, const int32_t k
+		, const int num_threads
+		, graph_view :: AdjacencyLists &truss) {
+	const int32_t N = g->numNodes();
+	const int32_t needed = k - 2; // triangles, for each edge
+
+	// start from the (k-1)-core, as it's cheap and it saves counting most of the triangles
+	graph_view :: AdjacencyLists core;
+	{
+		vector<char> in_core;
+		ordering :: k_core(g, k - 1, in_core);
+		core.lists.resize(N);
+		for(int32_t u = 0; u < N; u++) {
+			if(!in_core[u])
+				continue;
+			const graph_view :: Neighbours neighs = g->neighbours(u);
+			For(v, neighs)
+				if(in_core[*v])
+					core.lists[u].push_back(*v);
+		}
+	}
+
+	const Slots slots(core);
+	vector<int32_t> support(slots.offsets.back());
+	{
+		CountTriangles count(slots, support);
+		parallel :: for_each_index(N, num_threads, count);
+	}
+
+	// peel. An edge is queued when its support falls below 'needed', and dropped when it's taken from the queue
+	vector<char> alive(support.size(), 1);
+	vector< pair<int32_t, int32_t> > doomed;
+	for(int32_t u = 0; u < N; u++)
+		for(size_t i = 0; i < core.lists[u].size(); i++)
+			if(u < core.lists[u][i] && support[slots.offsets[u] + i] < needed)
+				doomed.push_back(make_pair(u, core.lists[u][i]));
+	while(!doomed.empty()) {
+		const int32_t u = doomed.back().first;
+		const int32_t v = doomed.back().second;
+		doomed.pop_back();
+		const int64_t uv = slots.slot(u, v);
+		if(!alive[uv])
+			continue;
+		alive[uv] = 0;
+		alive[slots.slot(v, u)] = 0;
+		// every triangle (u,v,w) that's left loses this edge
+		const vector<int32_t> &nu = core.lists[u];
+		const vector<int32_t> &nv = core.lists[v];
+		size_t a = 0, b = 0;
+		while(a < nu.size() && b < nv.size()) {
+			if(nu[a] < nv[b])
+				++a;
+			else if(nv[b] < nu[a])
+				++b;
+			else {
+				const int32_t w = nu[a];
+				const int64_t uw = slots.offsets[u] + a;
+				const int64_t vw = slots.offsets[v] + b;
+				if(alive[uw] && alive[vw]) {
+					const int64_t wu = slots.slot(w, u);
+					const int64_t wv = slots.slot(w, v);
+					-- support[uw];
+					-- support[wu];
+					-- support[vw];
+					-- support[wv];
+					if(support[uw] == needed - 1) // it has just fallen below
+						doomed.push_back(make_pair(u, w));
+					if(support[vw] == needed - 1)
+						doomed.push_back(make_pair(v, w));
+				}
+				++a;
+				++b;
+			}
+		}
+	}
+
+	int64_t edges = 0;
+	truss.lists.clear();
+	truss.lists.resize(N);
+	for(int32_t u = 0; u < N; u++) {
+		for(size_t i = 0; i < core.lists[u].size(); i++)
+			if(alive[slots.offsets[u] + i])
+				truss.lists[u].push_back(core.lists[u][i]);
+		edges += truss.lists[u].size();
+	}
+	return edges / 2;
+}
+
+} // namespace truss
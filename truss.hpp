@@ -0,0 +1,23 @@
+#ifndef _TRUSS_HPP_
+#define _TRUSS_HPP_
+
+#include "graph_view.hpp"
+
+namespace truss {
+
+/*
+ * The k-truss: repeatedly drop the edges that are in fewer than k-2 triangles (of the edges that remain).
+ * Every edge of a k-clique is in k-2 triangles within the clique, so the k-cliques survive, and
+ * a clique of size k or more is maximal in the k-truss iff it's maximal in the whole graph.
+ * The triangles are counted in parallel, with num_threads; the peeling is serial.
+ * 'truss' gets the same node ids as g (the nodes that lose all their edges are still there).
+ * Returns how many edges are left.
+ */
+int64_t k_truss(const graph_view :: Graph *g
+		, int32_t k
+		, int num_threads
+		, graph_view :: AdjacencyLists &truss);
+
+} // namespace truss
+
+#endif
@@ -0,0 +1,170 @@
+using namespace std;
+#include "graph/network.hpp"
+#include "graph/loading.hpp"
+#include "graph/stats.hpp"
+#include <getopt.h>
+#include <libgen.h>
+#include <ctime>
+#include <cassert>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <tr1/unordered_map>
+
+#include "macros.hpp"
+#include "cliques.hpp"
+#include "incremental.hpp"
+#include "cmdline-updateCliques.h"
+
+/*
+ * The cliques file is what justTheCliques prints: one clique per line, the node names separated by spaces.
+ * The changes file has one edge per line: "+ a b" inserts the edge between a and b, "- a b" deletes it.
+ * Lines starting with '#' are ignored in both. The nodes in the changes needn't be in the network yet.
+ * We print the cliques that disappear, prefixed with "- ", and those that appear, prefixed with "+ ".
+ */
+
+struct Names {
+	vector<string> names;
+	tr1 :: unordered_map<string, int32_t> ids;
+	int32_t id(const string &name, bool add_if_new) {
+		tr1 :: unordered_map<string, int32_t> :: const_iterator it = this->ids.find(name);
+		if(it != this->ids.end())
+			return it->second;
+		if(!add_if_new)
+			return -1;
+		this->names.push_back(name);
+		this->ids[name] = int32_t(this->names.size()) - 1;
+		return int32_t(this->names.size()) - 1;
+	}
+};
+
+static void print_clique(ostream &out, const char *prefix, const vector<int32_t> &clique, const Names &names) {
+	out << prefix;
+	for(size_t i = 0; i < clique.size(); i++)
+		out << (i ? " " : "") << names.names.at(clique.at(i));
+	out << '\n';
+}
+
+int main(int argc, char **argv) {
+	gengetopt_args_info args_info;
+
+	// there shouldn't be any errors in processing args
+	if (cmdline_parser (argc, argv, &args_info) != 0)
+		exit(1) ;
+	// .. and there should be exactly three non-option args
+	if(args_info.inputs_num != 3 || args_info.k_arg < 3 || args_info.threads_arg < 1) {
+		cmdline_parser_print_help();
+		exit(1);
+	}
+
+	const char * edgeListFileName   = args_info.inputs[0];
+	const char * cliquesFileName    = args_info.inputs[1];
+	const char * changesFileName    = args_info.inputs[2];
+	const int k = args_info.k_arg;
+
+        std :: auto_ptr<graph :: NetworkInterfaceConvertedToString > network;
+	if(args_info.stringIDs_flag) {
+		network	= graph :: loading :: make_Network_from_edge_list_string(edgeListFileName, false, false, true);
+	} else {
+		network	= graph :: loading :: make_Network_from_edge_list_int64(edgeListFileName, false, false, true, 0);
+	}
+	cerr << "Network loaded"
+	       << " after " << (double(clock()) / CLOCKS_PER_SEC) << " seconds. "
+		<< network.get()->numNodes() << " nodes and " << network.get()->numRels() << " edges."
+	       << endl;
+
+	Names names;
+	graph_view :: AdjacencyLists g;
+	{
+		const graph :: VerySimpleGraphInterface *vsg = network->get_plain_graph();
+		g.lists.resize(vsg->numNodes());
+		for(int32_t v = 0; v < vsg->numNodes(); v++) {
+			g.lists.at(v) = vsg->neighbouring_nodes_in_order(v);
+			const int32_t id = names.id(network->node_name_as_string(v), true);
+			assert(id == v);
+		}
+	}
+
+	incremental :: CliqueSet clique_set;
+	{
+		ifstream in(cliquesFileName);
+		unless(in) {
+			cerr << "Error: can't read the cliques from " << cliquesFileName << endl;
+			exit(1);
+		}
+		string line;
+		while(getline(in, line)) {
+			if(line.empty() || line[0] == '#')
+				continue;
+			istringstream fields(line);
+			vector<int32_t> clique;
+			string name;
+			while(fields >> name) {
+				const int32_t id = names.id(name, false);
+				if(id == -1) {
+					cerr << "Error: the cliques mention " << name << ", which isn't in the network" << endl;
+					exit(1);
+				}
+				clique.push_back(id);
+			}
+			sort(clique.begin(), clique.end());
+			clique_set.add(clique);
+		}
+	}
+	cerr << clique_set.size() << " cliques loaded" << endl;
+
+	vector<incremental :: EdgeChange> changes;
+	{
+		ifstream in(changesFileName);
+		unless(in) {
+			cerr << "Error: can't read the changes from " << changesFileName << endl;
+			exit(1);
+		}
+		string line;
+		while(getline(in, line)) {
+			if(line.empty() || line[0] == '#')
+				continue;
+			istringstream fields(line);
+			string sign, a, b;
+			unless((fields >> sign >> a >> b) && (sign == "+" || sign == "-")) {
+				cerr << "Error: each change should be \"+ a b\" or \"- a b\", not: " << line << endl;
+				exit(1);
+			}
+			changes.push_back(incremental :: EdgeChange(names.id(a, true), names.id(b, true), sign == "+"));
+		}
+	}
+
+	cliques :: SearchOptions options;
+	options.num_threads = args_info.threads_arg;
+	vector< vector<int32_t> > appeared, disappeared;
+	incremental :: apply(g, clique_set, changes, k, options, appeared, disappeared);
+	cerr << changes.size() << " changes applied. " << disappeared.size() << " cliques disappeared and " << appeared.size() << " appeared" << endl;
+
+	For(clique, disappeared)
+		print_clique(cout, "- ", *clique, names);
+	For(clique, appeared)
+		print_clique(cout, "+ ", *clique, names);
+	cout << flush;
+
+	if(args_info.cliques_out_given) {
+		ofstream out(args_info.cliques_out_arg);
+		For(clique, clique_set.cliques)
+			if(!clique->empty())
+				print_clique(out, "", *clique, names);
+		unless(out) {
+			cerr << "Error: failed to write the cliques to " << args_info.cliques_out_arg << endl;
+			exit(1);
+		}
+	}
+	if(args_info.edges_out_given) {
+		ofstream out(args_info.edges_out_arg);
+		for(int32_t u = 0; u < g.numNodes(); u++)
+			For(v, g.lists.at(u))
+				if(u < *v)
+					out << names.names.at(u) << '\t' << names.names.at(*v) << '\n';
+		unless(out) {
+			cerr << "Error: failed to write the edges to " << args_info.edges_out_arg << endl;
+			exit(1);
+		}
+	}
+}
@@ -0,0 +1,201 @@
+#include "writer.hpp"
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+#include <stdexcept>
+#include <unistd.h>
+#include "macros.hpp"
+using namespace std;
+
+namespace writer {
+
+static const size_t MAX_QUEUED_BUFFERS = 4;
+
+char * append_int64(char *out, int64_t x) {
+	char digits[20];
+	int n = 0;
+	uint64_t magnitude = x < 0 ? uint64_t(0) - uint64_t(x) : uint64_t(x);
+	do {
+		digits[n++] = char('0' + magnitude % 10);
+		magnitude /= 10;
+	} while(magnitude);
+	if(x < 0)
+		*out++ = '-';
+	while(n)
+		*out++ = digits[--n];
+	return out;
+}
+
+static bool parse_canonical_int64(const string &name, int64_t &x) { // only if formatting x gives back exactly the same string
+	if(name.empty() || name.size() > 20)
+		return false;
+	char *end = NULL;
+	errno = 0;
+	const long long parsed = strtoll(name.c_str(), &end, 10);
+	if(errno || *end != '\0')
+		return false;
+	char formatted[20];
+	const char *formatted_end = append_int64(formatted, parsed);
+	if(size_t(formatted_end - formatted) != name.size() || 0 != memcmp(formatted, name.data(), name.size()))
+		return false; // e.g. "007" or "+7"
+	x = parsed;
+	return true;
+}
+
+NodeNames :: NodeNames(const graph :: NetworkInterfaceConvertedToString *net) : N(net->numNodes()), int64_ids(true), ids(NULL), text_offsets(NULL), text(NULL), longest(0) {
+	this->own_ids.reserve(N);
+	this->own_text_offsets.reserve(N+1);
+	this->own_text_offsets.push_back(0);
+	for(int32_t v = 0; v < N; v++) {
+		const string name = net->node_name_as_string(v);
+		if(this->int64_ids) {
+			int64_t x;
+			if(parse_canonical_int64(name, x))
+				this->own_ids.push_back(x);
+			else
+				this->int64_ids = false;
+		}
+		this->own_text.insert(this->own_text.end(), name.begin(), name.end());
+		this->own_text_offsets.push_back(this->own_text.size());
+		if(this->longest < name.size())
+			this->longest = name.size();
+	}
+	if(this->int64_ids) {
+		vector<char>().swap(this->own_text);
+		vector<int64_t>().swap(this->own_text_offsets);
+		this->longest = 20;
+		this->ids = this->own_ids.empty() ? NULL : &this->own_ids.front();
+	} else {
+		vector<int64_t>().swap(this->own_ids);
+		this->text_offsets = &this->own_text_offsets.front();
+		this->text = this->own_text.empty() ? NULL : &this->own_text.front();
+	}
+}
+
+NodeNames :: NodeNames(int32_t num_nodes, const int64_t *_ids) : N(num_nodes), int64_ids(true), ids(_ids), text_offsets(NULL), text(NULL), longest(20) {
+}
+
+NodeNames :: NodeNames(int32_t num_nodes, const int64_t *_text_offsets, const char *_text) : N(num_nodes), int64_ids(false), ids(NULL), text_offsets(_text_offsets), text(_text), longest(0) {
+	for(int32_t v = 0; v < N; v++)
+		if(this->longest < size_t(this->text_offsets[v+1] - this->text_offsets[v]))
+			this->longest = size_t(this->text_offsets[v+1] - this->text_offsets[v]);
+}
+
+char * NodeNames :: append_name(char *out, int32_t node_id) const {
+	if(this->int64_ids)
+		return append_int64(out, this->ids[node_id]);
+	const int64_t begin = this->text_offsets[node_id];
+	const size_t len = size_t(this->text_offsets[node_id+1] - begin);
+	if(len)
+		memcpy(out, this->text + begin, len);
+	return out + len;
+}
+
+string NodeNames :: name(int32_t node_id) const {
+	if(this->int64_ids) {
+		char digits[20];
+		return string(digits, append_int64(digits, this->ids[node_id]));
+	}
+	return string(this->text + this->text_offsets[node_id], this->text + this->text_offsets[node_id+1]);
+}
+
+FdWriter :: FdWriter(int _fd, bool writer_thread, WriteListener *_listener) : fd(_fd), listener(_listener), threaded(false), closing(false), error_number(0) {
+	pthread_mutex_init(&this->lock, NULL);
+	pthread_cond_init(&this->queue_changed, NULL);
+	if(writer_thread)
+		this->threaded = (0 == pthread_create(&this->thread, NULL, writer_thread_main, this)); // otherwise, we just write synchronously
+}
+
+FdWriter :: ~FdWriter() {
+	try {
+		this->close();
+	} catch (std :: runtime_error &) {
+	}
+	For(b, this->spare)
+		delete *b;
+	pthread_cond_destroy(&this->queue_changed);
+	pthread_mutex_destroy(&this->lock);
+}
+
+void FdWriter :: write_all(const Buffer &b) {
+	const char *p = b.used ? &b.data.front() : NULL;
+	size_t n = b.used;
+	while(n > 0 && this->error_number == 0) {
+		const ssize_t written = ::write(this->fd, p, n);
+		if(written < 0) {
+			if(errno != EINTR)
+				this->error_number = errno;
+			continue;
+		}
+		p += written;
+		n -= written;
+	}
+	if(this->listener && this->error_number == 0)
+		this->listener->written(b);
+}
+
+void FdWriter :: write(Buffer &b) {
+	if(b.used == 0 && b.roots_done.empty())
+		return;
+	pthread_mutex_lock(&this->lock);
+	if(!this->threaded) {
+		this->write_all(b);
+		b.used = 0;
+		b.roots_done.clear();
+		pthread_mutex_unlock(&this->lock);
+		return;
+	}
+	while(this->queue.size() >= MAX_QUEUED_BUFFERS)
+		pthread_cond_wait(&this->queue_changed, &this->lock);
+	Buffer *full = NULL;
+	if(this->spare.empty())
+		full = new Buffer();
+	else {
+		full = this->spare.back();
+		this->spare.pop_back();
+	}
+	full->data.swap(b.data); // b gets the capacity of a buffer that has already been written
+	full->roots_done.swap(b.roots_done);
+	full->used = b.used;
+	this->queue.push_back(full);
+	b.used = 0;
+	b.roots_done.clear();
+	pthread_cond_broadcast(&this->queue_changed);
+	pthread_mutex_unlock(&this->lock);
+}
+
+void * FdWriter :: writer_thread_main(void *arg) {
+	FdWriter *w = static_cast<FdWriter *>(arg);
+	pthread_mutex_lock(&w->lock);
+	while(1) {
+		while(w->queue.empty() && !w->closing)
+			pthread_cond_wait(&w->queue_changed, &w->lock);
+		if(w->queue.empty())
+			break; // closing, and nothing left to write
+		Buffer *full = w->queue.front();
+		pthread_mutex_unlock(&w->lock);
+		w->write_all(*full); // only this thread touches error_number while the writer thread is running
+		pthread_mutex_lock(&w->lock);
+		w->queue.pop_front();
+		w->spare.push_back(full);
+		pthread_cond_broadcast(&w->queue_changed);
+	}
+	pthread_mutex_unlock(&w->lock);
+	return NULL;
+}
+
+void FdWriter :: close() {
+	if(this->threaded) {
+		pthread_mutex_lock(&this->lock);
+		this->closing = true;
+		pthread_cond_broadcast(&this->queue_changed);
+		pthread_mutex_unlock(&this->lock);
+		pthread_join(this->thread, NULL);
+		this->threaded = false;
+	}
+	if(this->error_number)
+		throw std :: runtime_error(string("failed to write the cliques: ") + strerror(this->error_number));
+}
+
+} // namespace writer
@@ -0,0 +1,94 @@
+#ifndef _WRITER_HPP_
+#define _WRITER_HPP_
+
+#include "graph/network.hpp"
+#include <vector>
+#include <deque>
+#include <string>
+#include <pthread.h>
+
+namespace writer {
+
+/*
+ * Every node's name, looked up once, so that writing a clique doesn't go through node_name_as_string().
+ * If every name is a plain int64 (as it is without --stringIDs) we keep just the numbers, and format
+ * them ourselves. Otherwise the names are copied, back-to-back, into one array of chars.
+ * A compiled graph (see compiled_graph.hpp) stores the names the same way, and they're used where they're mapped.
+ */
+struct NodeNames {
+	explicit NodeNames(const graph :: NetworkInterfaceConvertedToString *net);
+	NodeNames(int32_t num_nodes, const int64_t *ids); // uses the array, without copying it
+	NodeNames(int32_t num_nodes, const int64_t *text_offsets, const char *text); // likewise
+	size_t max_name_length() const { return this->longest; }
+	char * append_name(char *out, int32_t node_id) const; // there must be room for max_name_length() chars at 'out'. Returns the end of the name
+	std :: string name(int32_t node_id) const;
+	int32_t numNodes() const { return this->N; }
+	bool all_int64() const { return this->int64_ids; }
+	const int64_t * id_array() const { return this->ids; } // if all_int64()
+	const int64_t * offset_array() const { return this->text_offsets; } // otherwise. The name of v is text[text_offsets[v]] ... text[text_offsets[v+1]-1]
+	const char * text_array() const { return this->text; }
+private:
+	int32_t N;
+	bool int64_ids;
+	const int64_t *ids;
+	const int64_t *text_offsets;
+	const char *text;
+	std :: vector<int64_t> own_ids;
+	std :: vector<int64_t> own_text_offsets;
+	std :: vector<char> own_text;
+	size_t longest;
+	NodeNames(const NodeNames &);
+	NodeNames & operator= (const NodeNames &);
+};
+
+char * append_int64(char *out, int64_t x); // writes at most 20 chars, no terminating '\0'
+
+struct Buffer { // a growable array of chars, of which the first 'used' are wanted
+	std :: vector<char> data;
+	size_t used;
+	std :: vector<int32_t> roots_done; // for a checkpoint: the roots whose cliques are all written, once this buffer is
+	Buffer() : used(0) {}
+	char * reserve(size_t n) { // room for n more chars, at the end
+		if(this->used + n > this->data.size())
+			this->data.resize(this->used + n > 2 * this->data.size() ? this->used + n : 2 * this->data.size());
+		return &this->data[this->used];
+	}
+};
+
+struct WriteListener { // told about every buffer, in order, once it has been written
+	virtual void written(const Buffer &b) = 0;
+	virtual ~WriteListener() {}
+};
+
+/*
+ * Writes Buffers to a file descriptor with write(2), one call per buffer (more only if the kernel writes less).
+ * With a writer thread, write() just queues the buffer, and the caller can carry on
+ * with the search while the output is written. There are never more than a few buffers in the queue.
+ * Many threads may share one FdWriter. Each buffer is written whole, so lines are never interleaved.
+ */
+class FdWriter {
+public:
+	FdWriter(int fd, bool writer_thread, WriteListener *listener = NULL);
+	~FdWriter();
+	void write(Buffer &b); // takes the contents of b; b is empty (but keeps some capacity) afterwards
+	void close(); // waits until everything is written. Throws std::runtime_error if any write failed
+private:
+	const int fd;
+	WriteListener * const listener;
+	bool threaded;
+	bool closing;
+	int error_number; // errno of the first failed write, or 0
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t queue_changed;
+	std :: deque< Buffer * > queue;
+	std :: vector< Buffer * > spare;
+	void write_all(const Buffer &b); // the caller must hold the lock if there's no writer thread
+	static void * writer_thread_main(void *);
+	FdWriter(const FdWriter &);
+	FdWriter & operator= (const FdWriter &);
+};
+
+} // namespace writer
+
+#endif